@@ -0,0 +1,261 @@
+// Copyright (c) 2026, REGINDEX.  All rights reserved.
+// Use of this source code is governed
+// by a MIT license that can be found in the LICENSE file.
+/*
+    Benchmark of all the tools on deterministic synthetic inputs: uniform
+    random, low-entropy and collections of mutated copies of a random
+    string. Each tool runs as a child process, so that its wall time, CPU
+    time and peak resident set size are measured alone; the results are
+    printed one JSON object per line.
+*/
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <random>
+#include <chrono>
+#include <cstdio>
+#include <algorithm>
+#include <cstdlib>
+
+#include <unistd.h>
+#include <sys/wait.h>
+#include <sys/resource.h>
+
+#ifndef TOOLS_DIR
+#define TOOLS_DIR "."
+#endif
+
+// a tool and the options making it print |S| and the number of BWT runs
+struct engine_t{
+  std::string name;
+  std::string exe;
+  bool pfp;
+};
+
+const std::vector<engine_t> engines = {
+  {"suffixient", "suffixient", false},
+  {"one-pass", "one-pass", false},
+  {"lc", "lc", false},
+  {"plain_lc", "plain_lc", false},
+  {"fm", "fm", false},
+  {"pfp_suffixient", "pfp_suffixient", true}
+};
+
+const std::vector<std::string> inputs = {"random", "low_entropy", "repetitive"};
+
+void help(){
+
+  std::cout << "engine_benchmark [options]" << std::endl <<
+  "Run every tool on deterministic synthetic inputs. Output: one JSON object per run, with wall and CPU time, throughput, peak RSS, BWT runs and |S|." << std::endl <<
+  "Options:" << std::endl <<
+  "-h          Print usage info." << std::endl <<
+  "-d <arg>    Scratch directory for the inputs and outputs. Default: current directory." << std::endl <<
+  "-x <arg>    Directory of the tool executables. Default: " << TOOLS_DIR << "." << std::endl <<
+  "-n <arg>    Comma-separated input sizes in bytes. Default: 1048576,4194304,16777216." << std::endl <<
+  "-e <arg>    Comma-separated engines among suffixient, one-pass, lc, plain_lc, fm, pfp_suffixient. Default: all." << std::endl <<
+  "-t <arg>    Comma-separated inputs among random, low_entropy, repetitive. Default: all." << std::endl <<
+  "-T <arg>    Threads passed to the tools (-T, or -t for pfp_suffixient). Default: 1." << std::endl <<
+  "-o <arg>    Write the results to file instead of standard output." << std::endl;
+  exit(0);
+}
+
+std::vector<std::string> split(const std::string& s)
+{
+  std::vector<std::string> v;
+  std::stringstream ss(s);
+  for(std::string x; std::getline(ss, x, ','); )
+    if(x.length() != 0)
+      v.push_back(x);
+  return v;
+}
+
+// deterministic text of n bytes over characters 'A'.. (never 0, 1 or 2, which
+// PFP reserves). The raw output of mt19937_64 is fixed by the standard, so the
+// inputs are the same on every platform and release.
+std::string generate(const std::string& type, uint64_t n)
+{
+  std::mt19937_64 gen(n);
+  std::string T(n, 'A');
+  if(type == "random")
+  {
+    // uniform over 4 characters
+    for(auto& c: T)
+      c = "ACGT"[gen() % 4];
+  }
+  else if(type == "low_entropy")
+  {
+    // geometric distribution over 26 characters, each with probability 1/4
+    // of being followed by a rarer one
+    for(auto& c: T)
+    {
+      uint64_t k = 0;
+      while(k < 25 and gen() % 4 == 0)
+        ++k;
+      c = char('a' + k);
+    }
+  }
+  else
+  {
+    // copies of a random string of n/64 characters, each with 0.1% of its
+    // characters substituted
+    std::string base(std::max<uint64_t>(1, n / 64), 'A');
+    for(auto& c: base)
+      c = "ACGT"[gen() % 4];
+    for(uint64_t i = 0; i < n; ++i)
+      T[i] = gen() % 1000 == 0 ? "ACGT"[gen() % 4] : base[i % base.size()];
+  }
+  return T;
+}
+
+struct result_t{
+  int status = -1;
+  double wall = 0, cpu = 0;
+  long rss_kb = 0;
+  std::string out;
+};
+
+// run argv as a child process, collecting its standard output and resources
+result_t run(const std::vector<std::string>& argv)
+{
+  result_t r;
+  int fd[2];
+  if(pipe(fd) != 0)
+    return r;
+
+  auto start = std::chrono::steady_clock::now();
+  pid_t pid = fork();
+  if(pid == 0)
+  {
+    dup2(fd[1], 1);
+    close(fd[0]);
+    close(fd[1]);
+    std::vector<char*> args;
+    for(auto& a: argv)
+      args.push_back(const_cast<char*>(a.c_str()));
+    args.push_back(nullptr);
+    execv(args[0], args.data());
+    _exit(127);
+  }
+  close(fd[1]);
+  char buf[1 << 16];
+  for(ssize_t k; (k = read(fd[0], buf, sizeof(buf))) > 0; )
+    r.out.append(buf, k);
+  close(fd[0]);
+
+  int status;
+  struct rusage ru;
+  if(pid < 0 or wait4(pid, &status, 0, &ru) < 0)
+    return r;
+  r.wall = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  r.cpu = ru.ru_utime.tv_sec + ru.ru_stime.tv_sec + (ru.ru_utime.tv_usec + ru.ru_stime.tv_usec) / 1e6;
+  r.rss_kb = ru.ru_maxrss;
+  r.status = WIFEXITED(status) ? WEXITSTATUS(status) : -1;
+  return r;
+}
+
+// integer at the end of the first output line starting with prefix, or -1
+long long counter(const std::string& out, const std::string& prefix)
+{
+  std::stringstream ss(out);
+  for(std::string line; std::getline(ss, line); )
+    if(line.compare(0, prefix.length(), prefix) == 0)
+      return std::stoll(line.substr(line.find_last_of(':') + 1));
+  return -1;
+}
+
+int main(int argc, char* const argv[])
+{
+  std::string scratch = ".", tools = TOOLS_DIR, output_file;
+  std::vector<std::string> sizes = {"1048576", "4194304", "16777216"};
+  std::vector<std::string> selected_engines, selected_inputs = inputs;
+  for(auto& e: engines)
+    selected_engines.push_back(e.name);
+  long threads = 1;
+
+  int opt;
+  while ((opt = getopt(argc, argv, "hd:x:n:e:t:T:o:")) != -1){
+    switch (opt){
+      case 'd':
+        scratch = std::string(optarg);
+      break;
+      case 'x':
+        tools = std::string(optarg);
+      break;
+      case 'n':
+        sizes = split(optarg);
+      break;
+      case 'e':
+        selected_engines = split(optarg);
+      break;
+      case 't':
+        selected_inputs = split(optarg);
+      break;
+      case 'T':
+      {
+        char* end;
+        threads = strtol(optarg, &end, 10);
+        if(*optarg == '\0' or *end != '\0' or threads < 1)
+        {
+          std::cerr << "Error: -T takes a positive number of threads" << std::endl;
+          help();
+        }
+      }
+      break;
+      case 'o':
+        output_file = std::string(optarg);
+      break;
+      default:
+        help();
+      return -1;
+    }
+  }
+
+  std::ofstream file;
+  if(output_file.length() != 0)
+    file.open(output_file);
+  std::ostream& json = output_file.length() != 0 ? file : std::cout;
+
+  for(auto& type: selected_inputs)
+    for(auto& size: sizes)
+    {
+      uint64_t n = std::stoull(size);
+      std::string input = scratch + "/" + type + "." + size + ".txt";
+      std::string output = scratch + "/" + type + "." + size + ".out";
+      {
+        std::string T = generate(type, n);
+        std::ofstream(input, std::ios::binary).write(T.data(), T.size());
+      }
+
+      for(auto& name: selected_engines)
+        for(auto& e: engines)
+        {
+          if(e.name != name)
+            continue;
+
+          std::vector<std::string> args = {tools + "/" + e.exe};
+          if(e.pfp)
+            args.insert(args.end(), {"-f", input, "-d", scratch, "-t", std::to_string(threads), "-o", output, "-p", "-r"});
+          else
+            args.insert(args.end(), {"-i", input, "-T", std::to_string(threads), "-o", output, "-p", "-r"});
+
+          result_t r = run(args);
+          long long s = counter(r.out, "Size of smallest suffixient set");
+          long long runs = counter(r.out, "Number of equal-letter");
+
+          json << "{\"engine\":\"" << e.name << "\",\"input\":\"" << type << "\",\"n\":" << n
+               << ",\"threads\":" << threads << ",\"status\":" << r.status
+               << ",\"wall_s\":" << r.wall << ",\"cpu_s\":" << r.cpu
+               << ",\"mb_per_s\":" << (r.wall > 0 ? n / r.wall / 1e6 : 0)
+               << ",\"peak_rss_kb\":" << r.rss_kb
+               << ",\"bwt_runs\":" << runs << ",\"suffixient_size\":" << s
+               << ",\"size_over_runs\":" << (runs > 0 ? double(s) / runs : 0) << "}" << std::endl;
+        }
+      std::remove(input.c_str());
+      std::remove(output.c_str());
+    }
+
+  return 0;
+}
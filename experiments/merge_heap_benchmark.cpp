@@ -0,0 +1,133 @@
+// Copyright (c) 2026, REGINDEX.  All rights reserved.
+// Use of this source code is governed
+// by a MIT license that can be found in the LICENSE file.
+/*
+    Per-element cost of the k-way merge of the pfp_iterator: the previous
+    std::priority_queue with a std::function comparator against merge_heap,
+    on k sorted ranges of a bit-compressed inverted list.
+*/
+
+#include <iostream>
+#include <queue>
+#include <vector>
+#include <random>
+#include <chrono>
+#include <functional>
+#include <unistd.h>
+
+#include <sdsl/int_vector.hpp>
+
+#include <merge_heap.hpp>
+
+typedef sdsl::int_vector<>::const_iterator ilist_it;
+typedef std::pair<ilist_it, std::pair<ilist_it, uint8_t>> pq_t;
+
+// the queue used by pfp_iterator before merge_heap
+class function_queue {
+public:
+    function_queue() : pq(comp) {}
+    void push(const pq_t& item) { pq.push(item); }
+    void pop() { pq.pop(); }
+    pq_t top() const { return pq.top(); }
+    bool empty() const { return pq.empty(); }
+private:
+    std::function<bool(const pq_t&, const pq_t&)> comp = [](const pq_t& a, const pq_t& b){ return *a.first > *b.first; };
+    std::priority_queue<pq_t, std::vector<pq_t>, std::function<bool(const pq_t&, const pq_t&)>> pq;
+};
+
+void help(){
+
+  std::cout << "merge_heap_benchmark [options]" << std::endl <<
+  "Merge k sorted ranges holding a random permutation of 0..n-1, with both queues." << std::endl <<
+  "Output: one line per queue with k, n and nanoseconds per element." << std::endl <<
+  "Options:" << std::endl <<
+  "-h          Print usage info." << std::endl <<
+  "-k <arg>    Number of ranges. Default: 16." << std::endl <<
+  "-n <arg>    Number of elements. Default: 2^24." << std::endl <<
+  "-r <arg>    Repetitions. Default: 5." << std::endl;
+  exit(0);
+}
+
+template<class t_fun>
+void measure(const std::string& name, uint64_t k, uint64_t n, uint64_t reps, t_fun merge)
+{
+  uint64_t checksum = 0;
+  auto start = std::chrono::steady_clock::now();
+  for(uint64_t r = 0; r < reps; ++r)
+    checksum += merge();
+  double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+  std::cout << name << "\tk=" << k << "\tn=" << n << "\tns_per_element=" << ns / (reps * n)
+            << "\tchecksum=" << checksum << std::endl;
+}
+
+int main(int argc, char* const argv[])
+{
+  uint64_t k = 16, n = 1 << 24, reps = 5;
+
+  int opt;
+  while ((opt = getopt(argc, argv, "hk:n:r:")) != -1){
+    switch (opt){
+      case 'k':
+        k = std::strtoull(optarg, nullptr, 10);
+      break;
+      case 'n':
+        n = std::strtoull(optarg, nullptr, 10);
+      break;
+      case 'r':
+        reps = std::strtoull(optarg, nullptr, 10);
+      break;
+      default:
+        help();
+      return -1;
+    }
+  }
+  if(k == 0 or n < k) help();
+
+  // k consecutive ranges of n/k sorted values each, interleaved at random
+  std::mt19937_64 gen(42);
+  std::vector<uint64_t> owner(n);
+  for(uint64_t i = 0; i < n; ++i)
+    owner[i] = i % k;
+  std::shuffle(owner.begin(), owner.end(), gen);
+  std::vector<uint64_t> begin(k + 1, 0);
+  for(auto o: owner)
+    begin[o + 1]++;
+  for(uint64_t j = 0; j < k; ++j)
+    begin[j + 1] += begin[j];
+  sdsl::int_vector<> ilist(n, 0, sdsl::bits::hi(n) + 1);
+  std::vector<uint64_t> next(begin.begin(), begin.end() - 1);
+  for(uint64_t i = 0; i < n; ++i)
+    ilist[next[owner[i]]++] = i;
+
+  measure("std::function priority_queue", k, n, reps, [&](){
+    function_queue pq;
+    for(uint64_t j = 0; j < k; ++j)
+      pq.push({ilist.begin() + begin[j], {ilist.begin() + begin[j + 1], uint8_t(j)}});
+    uint64_t sum = 0;
+    while(not pq.empty())
+    {
+      auto occ = pq.top();
+      pq.pop();
+      sum += *occ.first ^ occ.second.second;
+      ++occ.first;
+      if(occ.first != occ.second.first)
+        pq.push(occ);
+    }
+    return sum;
+  });
+
+  measure("merge_heap", k, n, reps, [&](){
+    merge_heap<ilist_it> pq;
+    for(uint64_t j = 0; j < k; ++j)
+      pq.push(ilist.begin() + begin[j], ilist.begin() + begin[j + 1], uint8_t(j));
+    uint64_t sum = 0;
+    while(not pq.empty())
+    {
+      sum += pq.top().key ^ pq.top().tag;
+      pq.next();
+    }
+    return sum;
+  });
+
+  return 0;
+}
@@ -0,0 +1,109 @@
+// Copyright (c) 2026, REGINDEX.  All rights reserved.
+// Use of this source code is governed
+// by a MIT license that can be found in the LICENSE file.
+/*
+    k-way merge of sorted ranges of the inverted list of the parse. The
+    ranges sit in a 4-ary min-heap keyed by their current value, cached so
+    that comparisons do not decode the list again; moving past the smallest
+    value is a single sift-down of the top range.
+*/
+
+#ifndef _MERGE_HEAP_HH
+#define _MERGE_HEAP_HH
+
+#include <vector>
+#include <cstdint>
+#include <algorithm>
+
+template <class t_it, class t_tag = uint8_t>
+class merge_heap {
+public:
+
+    struct range {
+        uint64_t key;  // value at cur
+        t_it cur, end;
+        t_tag tag;
+    };
+
+    // add the non-empty range [begin, end)
+    void push(t_it begin, t_it end, t_tag tag)
+    {
+        heap.push_back({uint64_t(*begin), begin, end, tag});
+        sift_up(heap.size() - 1);
+    }
+
+    // range holding the smallest current value
+    const range& top() const
+    {
+        return heap[0];
+    }
+
+    // move past the smallest current value, dropping its range once exhausted
+    void next()
+    {
+        range& r = heap[0];
+        if (++r.cur == r.end)
+        {
+            r = heap.back();
+            heap.pop_back();
+            if (heap.empty())
+                return;
+        }
+        else
+            r.key = *r.cur;
+        sift_down(0);
+    }
+
+    bool empty() const
+    {
+        return heap.empty();
+    }
+
+    size_t size() const
+    {
+        return heap.size();
+    }
+
+private:
+
+    static constexpr size_t d = 4;
+
+    std::vector<range> heap;
+
+    void sift_up(size_t i)
+    {
+        range x = heap[i];
+        while (i > 0)
+        {
+            size_t p = (i - 1) / d;
+            if (heap[p].key <= x.key)
+                break;
+            heap[i] = heap[p];
+            i = p;
+        }
+        heap[i] = x;
+    }
+
+    void sift_down(size_t i)
+    {
+        range x = heap[i];
+        const size_t n = heap.size();
+        while (true)
+        {
+            size_t c = d * i + 1;
+            if (c >= n)
+                break;
+            size_t best = c;
+            for (size_t k = c + 1; k < std::min(c + d, n); ++k)
+                if (heap[k].key < heap[best].key)
+                    best = k;
+            if (heap[best].key >= x.key)
+                break;
+            heap[i] = heap[best];
+            i = best;
+        }
+        heap[i] = x;
+    }
+};
+
+#endif /* end of include guard: _MERGE_HEAP_HH */
@@ -9,6 +9,8 @@
 #ifndef _PFP_ITERATOR_HH
 #define _PFP_ITERATOR_HH
 
+#include <limits>
+
 #include <common.hpp>
 
 #include <sdsl/rmq_support.hpp>
@@ -19,23 +21,50 @@ extern "C"
 }
 
 #include <pfp.hpp>
-#include <priority_queue.hpp>
+#include <merge_heap.hpp>
+
+/*
+ * bit-compressed copy (at most 40 bits per entry for 64-bit builds) of the
+ * inverted list of the parse of pf, whose int_t list is then released: call
+ * it once, when pf.pars.ilist is no longer needed, and pass the copy to the
+ * iterators on pf. Both lists are in memory while copying.
+ */
+inline sdsl::int_vector<> compact_ilist(pf_parsing &pf)
+{
+    uint64_t max = 0;
+    for(size_t k = 0; k < pf.pars.ilist.size(); ++k)
+        max = std::max<uint64_t>(max, pf.pars.ilist[k]);
+    sdsl::int_vector<> ilist(pf.pars.ilist.size(), 0, max == 0 ? 1 : sdsl::bits::hi(max) + 1);
+    for(size_t k = 0; k < pf.pars.ilist.size(); ++k)
+        ilist[k] = pf.pars.ilist[k];
+    decltype(pf.pars.ilist)().swap(pf.pars.ilist);
+    return ilist;
+}
 
 class pfp_iterator{
 public:
 
-    pfp_iterator(pf_parsing &pfp_, std::string filename) : 
+    // ilist_ is the inverted list of the parse of pfp_ given by compact_ilist(),
+    // which must outlive the iterator
+    pfp_iterator(pf_parsing &pfp_, const sdsl::int_vector<> &ilist_, std::string filename) :
                 pf(pfp_),
                 min_s(1, pf.n),
                 pos_s(1,0),
-                head(0)
-    { assert(pf.dict.d[pf.dict.saD[0]] == EndOfDict); } 
+                head(0),
+                ilist(ilist_)
+    {
+        assert(pf.dict.d[pf.dict.saD[0]] == EndOfDict);
+    }
 
     void process_next_block()
     {
         while (not is_finished())
         {
             if(is_valid(curr)){
+                // minimum lcpD from the previous block to curr
+                lcp_boundary = lcp_run;
+                lcp_run = std::numeric_limits<int_t>::max();
+
                 // Compute the next character of the BWT of T
                 // Store the list of all phrase ids with the same suffix.
                 std::vector<phrase_suffix_t> same_suffix(1, curr); 
@@ -49,6 +78,7 @@ public:
                     if (next.suffix_length == curr.suffix_length)
                     {
                         same_suffix.push_back(next);
+                        lcp_run = std::numeric_limits<int_t>::max();
                     }
                 }
 
@@ -59,7 +89,7 @@ public:
                 {
                     size_t begin = pf.pars.select_ilist_s(s.phrase + 1);
                     size_t end = pf.pars.select_ilist_s(s.phrase + 2);
-                    pq.push({&pf.pars.ilist[begin], {&pf.pars.ilist[end], s.bwt_char}});
+                    pq.push(ilist.begin() + begin, ilist.begin() + end, s.bwt_char);
                 }
 
                 assert(pq.size() > 0);
@@ -89,36 +119,48 @@ public:
                 return false;
         }
 
-        auto curr_occ = pq.top();
-        pq.pop();
+        const auto& curr_occ = pq.top();
 
         if (!first)
         {
             // Compute the minimum s_lcpP of the the current and previous occurrence of the phrase in BWT_P
-            lcp_suffix = curr.suffix_length + min_s_lcp_T(*curr_occ.first, prev_occ);
+            lcp_suffix = curr.suffix_length + min_s_lcp_T(curr_occ.key, prev_occ);
         }
         first = false;
 
         // update LCP, SA and BWT entries
         update_lcp(lcp_suffix);
 
-        update_sa(curr, *curr_occ.first);
+        update_sa(curr, curr_occ.key);
 
-        update_bwt(curr_occ.second.second);
+        update_bwt(curr_occ.tag);
 
         // Update prevs
-        prev_occ = *curr_occ.first;
+        prev_occ = curr_occ.key;
 
         // Update pq
-        curr_occ.first++;
-        if (curr_occ.first != curr_occ.second.first)
-            pq.push(curr_occ);
+        pq.next();
 
         j += 1;
 
         return true;
     }
 
+    // write the next entries of SA, LCP and BWT in sa, lcp and bwt, up to n of
+    // them, and return how many were written (0 once the stream is over)
+    size_t next_batch(uint64_t *sa, int_t *lcp, uint8_t *bwt, size_t n)
+    {
+        size_t k = 0;
+        while (k < n and ++(*this))
+        {
+            sa[k] = sas;
+            lcp[k] = lcpe;
+            bwt[k] = head;
+            ++k;
+        }
+        return k;
+    }
+
     bool is_finished()
     {
         // if the queue is empty and there are no more BWT blocks we stop
@@ -169,9 +211,14 @@ private:
     bool first;
     int_t lcp_suffix;
 
-    // define the priority queue data structure
-    typedef std::pair<int_t *, std::pair<int_t *, uint8_t>> pq_t;
-    PriorityQueue<pq_t> pq;
+    int_t lcp_run = std::numeric_limits<int_t>::max(); // minimum lcpD since the last suffix of the current block
+    int_t lcp_boundary = 0; // minimum lcpD from the last suffix of the previous block to curr
+
+    // inverted list of the parse, bit-compressed
+    const sdsl::int_vector<> &ilist;
+
+    // merge of the occurrences in BWT_P of the phrases with the same suffix
+    merge_heap<sdsl::int_vector<>::const_iterator> pq;
 
     inline bool inc(phrase_suffix_t& s)
     {
@@ -179,9 +226,10 @@ private:
         if (s.i >= pf.dict.saD.size())
             return false;
         s.sn = pf.dict.saD[s.i];
+        lcp_run = std::min(lcp_run, int_t(pf.dict.lcpD[s.i]));
         s.phrase = pf.dict.rank_b_d(s.sn);
         // s.phrase = pf.dict.daD[s.i] + 1; // + 1 because daD is 0-based
-        assert(!is_valid(s) || (s.phrase > 0 && s.phrase < pf.pars.ilist.size()));
+        assert(!is_valid(s) || (s.phrase > 0 && s.phrase < ilist.size()));
         s.suffix_length = pf.dict.select_b_d(pf.dict.rank_b_d(s.sn + 1) + 1) - s.sn - 1;
         if(is_valid(s))
             s.bwt_char = (s.sn == pf.w ? 0 : pf.dict.d[s.sn - 1]);
@@ -217,20 +265,17 @@ private:
 
         if (j > 0)
         {
-            // Compute phrase boundary lcp
-            lcp_suffix = pf.dict.lcpD[curr.i];
-            for (size_t k = prev.i + 1; k < curr.i; ++k)
-            {
-                lcp_suffix = std::min(lcp_suffix, pf.dict.lcpD[k]);
-            }
+            // Compute phrase boundary lcp, the minimum of lcpD[prev.i+1..curr.i]
+            // maintained by inc()
+            lcp_suffix = lcp_boundary;
 
             if (lcp_suffix >= curr.suffix_length && curr.suffix_length == prev.suffix_length)
             {
                 // Compute the minimum s_lcpP of the phrases following the two phrases
                 // we take the first occurrence of the phrase in BWT_P
-                size_t left = pf.pars.ilist[pf.pars.select_ilist_s(curr.phrase + 1)]; //size_t left = first_P_BWT_P[phrase];
+                size_t left = ilist[pf.pars.select_ilist_s(curr.phrase + 1)]; //size_t left = first_P_BWT_P[phrase];
                 // and the last occurrence of the previous phrase in BWT_P
-                size_t right = pf.pars.ilist[pf.pars.select_ilist_s(prev.phrase + 2) - 1]; //last_P_BWT_P[prev_phrase];
+                size_t right = ilist[pf.pars.select_ilist_s(prev.phrase + 2) - 1]; //last_P_BWT_P[prev_phrase];
                 
                 lcp_suffix += min_s_lcp_T(left,right);
             }
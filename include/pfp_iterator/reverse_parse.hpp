@@ -0,0 +1,344 @@
+// Copyright (c) 2026, REGINDEX.  All rights reserved.
+// Use of this source code is governed
+// by a MIT license that can be found in the LICENSE file.
+/*
+    Prefix-free parsing of the reversed text, read backwards from the file
+    through a block buffer, so that no reversed copy of the text is stored.
+    Phrases are cut as in Big-BWT (newscan): a phrase ends when the
+    Karp-Rabin fingerprint of the last w characters is 0 modulo p, the
+    first phrase starts with a Dollar (2) and the last one ends with w of them.
+    The .dict, .occ and .parse files written are those read by pf_parsing.
+    With several threads the text is split in segments parsed concurrently,
+    each one from its first phrase boundary to the first boundary past its
+    end: a boundary depends only on the window of w characters ending there,
+    so the phrases of the segments concatenate to the sequential parse.
+*/
+
+#ifndef _PFP_REVERSE_PARSE_HH
+#define _PFP_REVERSE_PARSE_HH
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <algorithm>
+#include <stdexcept>
+#include <cstdio>
+#include <cstdint>
+#include <limits>
+
+#include <parallel.hpp>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+namespace suffixient{
+
+// reads a file from its last byte to its first one
+class reverse_reader{
+public:
+
+  // start from the character at position from of the reversed file
+  reverse_reader(const std::string& path, uint64_t from = 0, size_t block_size = 1 << 20) : buffer(block_size)
+  {
+    fd = open(path.c_str(), O_RDONLY);
+    if(fd < 0)
+      throw std::runtime_error("open() file " + path + " failed");
+
+    struct stat st;
+    if(fstat(fd, &st) != 0)
+    {
+      close(fd);
+      throw std::runtime_error("stat() file " + path + " failed");
+    }
+    n = st.st_size;
+    remaining = n - std::min(n, from);
+  }
+
+  ~reverse_reader() { close(fd); }
+
+  reverse_reader(const reverse_reader&) = delete;
+  reverse_reader& operator=(const reverse_reader&) = delete;
+
+  // next character, or EOF after the first byte of the file
+  int get()
+  {
+    if(i == 0)
+    {
+      if(remaining == 0)
+        return EOF;
+      fill();
+    }
+    return (unsigned char)buffer[--i];
+  }
+
+  // file size
+  uint64_t size() const { return n; }
+
+private:
+
+  int fd = -1;
+  uint64_t n = 0;
+  uint64_t remaining = 0;  // bytes before the buffered block
+  std::vector<char> buffer;
+  size_t i = 0;            // unread bytes of the buffered block
+
+  void fill()
+  {
+    size_t len = std::min<uint64_t>(remaining, buffer.size());
+    remaining -= len;
+    for(size_t done = 0; done < len; )
+    {
+      ssize_t r = pread(fd, buffer.data() + done, len - done, remaining + done);
+      if(r <= 0)
+        throw std::runtime_error("read error");
+      done += r;
+    }
+    i = len;
+  }
+};
+
+class reverse_parser{
+public:
+
+  static constexpr int end_of_dict = 0;
+  static constexpr int end_of_word = 1;
+  static constexpr int dollar = 2;
+
+  // segments parsed by different threads are at least this long
+  static constexpr uint64_t min_segment = 1 << 20;
+
+  reverse_parser(size_t w_ = 10, uint64_t p_ = 100) : w(w_), p(p_) {}
+
+  // parse the reversed content of file path with the given number of threads,
+  // store basepath.dict, basepath.occ and basepath.parse and return the length
+  // of the text
+  uint64_t run(const std::string& path, const std::string& basepath, uint64_t threads = 1)
+  {
+    uint64_t n = reverse_reader(path).size();
+    threads = std::max<uint64_t>(1, std::min(threads, n / std::max<uint64_t>(uint64_t(min_segment), w)));
+
+    std::vector<segment> parts(threads);
+    uint64_t block = (n + threads - 1) / threads;
+    parallel_for(threads, [&](uint64_t k){
+      try{
+        parse_segment(path, k * block, std::min(n, (k + 1) * block), parts[k]);
+      }catch(const std::exception& e){
+        parts[k].error = e.what();
+      }
+    });
+    for(auto& s: parts)
+      if(s.error.length() != 0)
+        throw std::runtime_error(s.error);
+
+    all = std::move(parts[0]);
+    for(uint64_t k = 1; k < threads; ++k)
+    {
+      std::vector<uint32_t> id(parts[k].phrases.size());
+      for(uint32_t j = 0; j < id.size(); ++j)
+        id[j] = all.add(*parts[k].phrases[j], parts[k].occ[j]);
+      for(auto x: parts[k].parse)
+        all.parse.push_back(id[x]);
+      parts[k] = segment();
+    }
+
+    write(basepath);
+    return n;
+  }
+
+  // number of distinct phrases and length of the parse of the last text
+  uint64_t dictionary_size() const { return all.phrases.size(); }
+  uint64_t parse_size() const { return all.parse.size(); }
+
+private:
+
+  // Karp-Rabin fingerprint of a window of w characters
+  struct kr_window{
+    static constexpr uint64_t prime = 1999999973;
+    static constexpr uint64_t asize = 256;
+
+    std::vector<int> window;
+    uint64_t asize_pot = 1;  // asize^(w-1) mod prime
+    uint64_t hash = 0;
+    uint64_t tot_char = 0;
+
+    kr_window(size_t w) : window(w, 0)
+    {
+      for(size_t k = 1; k < w; ++k)
+        asize_pot = (asize_pot * asize) % prime;
+    }
+
+    uint64_t addchar(int c)
+    {
+      size_t k = tot_char++ % window.size();
+      hash += (prime - (window[k] * asize_pot) % prime);
+      hash = (asize * hash + c) % prime;
+      window[k] = c;
+      return hash;
+    }
+
+    // characters of the window, oldest first
+    std::string get_window() const
+    {
+      std::string s;
+      for(size_t k = 0; k < window.size(); ++k)
+        s.push_back(char(window[(tot_char + k) % window.size()]));
+      return s;
+    }
+  };
+
+  // phrases of (a segment of) the parse
+  struct segment{
+    std::unordered_map<std::string, uint32_t> ids;  // phrase -> id, by first occurrence
+    std::vector<const std::string*> phrases;        // phrases, by id
+    std::vector<uint32_t> occ;                      // occurrences, by id
+    std::vector<uint32_t> parse;                    // ids, then ranks, of the phrases
+    std::string error;
+
+    // id of phrase s, adding occ occurrences
+    uint32_t add(const std::string& s, uint64_t k)
+    {
+      auto it = ids.find(s);
+      if(it == ids.end())
+      {
+        if(phrases.size() == std::numeric_limits<uint32_t>::max() - 1)
+          throw std::length_error("too many distinct phrases: increase the modulus");
+        it = ids.emplace(s, phrases.size()).first;
+        phrases.push_back(&it->first);
+        occ.push_back(0);
+      }
+      if(occ[it->second] + k > std::numeric_limits<uint32_t>::max())
+        throw std::length_error("phrase occurrence count overflow");
+      occ[it->second] += k;
+      return it->second;
+    }
+  };
+
+  size_t w;
+  uint64_t p;
+
+  segment all;
+
+  // parse the phrases of the reversed text starting at the first boundary at
+  // or after position b (the text start for b = 0) and ending at the first
+  // boundary at or after position e (the text end, if none)
+  void parse_segment(const std::string& path, uint64_t b, uint64_t e, segment& s)
+  {
+    if(b > 0 and b >= e)
+      return;
+
+    uint64_t i = b < w ? 0 : b - w;
+    reverse_reader in(path, i);
+
+    kr_window krw(w);
+    std::string word;
+    int c;
+    if(b == 0)
+      word.push_back(char(dollar));
+    else
+    {
+      // fill the window with the w characters before b, then move to the
+      // first boundary
+      for(; i < b; ++i)
+        krw.addchar(next_char(in, path));
+      while(true)
+      {
+        if(i >= e or (c = in.get()) == EOF)
+          return;
+        check_char(c, path);
+        if(krw.addchar(c) % p == 0)
+          break;
+        ++i;
+      }
+      word = krw.get_window();
+      ++i;
+    }
+
+    for(; (c = in.get()) != EOF; ++i)
+    {
+      check_char(c, path);
+      word.push_back(char(c));
+      if(krw.addchar(c) % p == 0)
+      {
+        save_update_word(word, s);
+        if(i >= e)
+          return;
+      }
+    }
+    // virtually add w Dollars at the end of the text
+    word.append(w, char(dollar));
+    save_update_word(word, s);
+  }
+
+  static void check_char(int c, const std::string& path)
+  {
+    if(c <= dollar)
+      throw std::runtime_error("invalid character " + std::to_string(c) + " in " + path);
+  }
+
+  static int next_char(reverse_reader& in, const std::string& path)
+  {
+    int c = in.get();
+    check_char(c, path);
+    return c;
+  }
+
+  // store the current phrase and keep its last w characters
+  void save_update_word(std::string& word, segment& s)
+  {
+    if(word.size() <= w)
+      return;
+
+    s.parse.push_back(s.add(word, 1));
+
+    word.erase(0, word.size() - w);
+  }
+
+  // write the sorted dictionary with the occurrences of its phrases and the
+  // parse as 1-based ranks in the dictionary
+  void write(const std::string& basepath)
+  {
+    auto& phrases = all.phrases;
+    std::vector<uint32_t> order(phrases.size());
+    for(uint32_t k = 0; k < order.size(); ++k)
+      order[k] = k;
+    std::sort(order.begin(), order.end(),
+              [&](uint32_t a, uint32_t b){ return *phrases[a] < *phrases[b]; });
+
+    std::vector<uint32_t> rank(phrases.size());
+    FILE *dict = open_file(basepath + ".dict");
+    FILE *occs = open_file(basepath + ".occ");
+    for(uint32_t k = 0; k < order.size(); ++k)
+    {
+      const std::string& s = *phrases[order[k]];
+      rank[order[k]] = k + 1;
+      if(fwrite(s.data(), 1, s.size(), dict) != s.size() or fputc(end_of_word, dict) == EOF)
+        throw std::runtime_error("error writing " + basepath + ".dict");
+      if(fwrite(&all.occ[order[k]], sizeof(uint32_t), 1, occs) != 1)
+        throw std::runtime_error("error writing " + basepath + ".occ");
+    }
+    if(fputc(end_of_dict, dict) == EOF)
+      throw std::runtime_error("error writing " + basepath + ".dict");
+    fclose(dict);
+    fclose(occs);
+
+    for(auto& x: all.parse)
+      x = rank[x];
+    FILE *pars = open_file(basepath + ".parse");
+    if(fwrite(all.parse.data(), sizeof(uint32_t), all.parse.size(), pars) != all.parse.size())
+      throw std::runtime_error("error writing " + basepath + ".parse");
+    fclose(pars);
+  }
+
+  static FILE* open_file(const std::string& path)
+  {
+    FILE *f = fopen(path.c_str(), "wb");
+    if(f == nullptr)
+      throw std::runtime_error("open() file " + path + " failed");
+    return f;
+  }
+};
+
+} // namespace suffixient
+
+#endif /* end of include guard: _PFP_REVERSE_PARSE_HH */
@@ -0,0 +1,161 @@
+// Copyright (c) 2026, REGINDEX.  All rights reserved.
+// Use of this source code is governed
+// by a MIT license that can be found in the LICENSE file.
+/*
+    Persistent cache of the SA and LCP arrays of a text, shared by the
+    runs of the tools. The arrays are stored as sdsl int_vector files
+    <key>.sa and <key>.lcp in a cache directory, where the key is a
+    128-bit hash of the text as given to the construction (reversed,
+    remapped, with the terminator), of its length, of its symbol width
+    and of the collection mode with its separator. A later run on the same text maps them in memory read-only
+    instead of building them. Files are written under a temporary name
+    and then renamed, so that concurrent runs never map a partial array.
+*/
+
+#ifndef _SUFFIXIENT_ARRAY_CACHE_HH
+#define _SUFFIXIENT_ARRAY_CACHE_HH
+
+#include <string>
+#include <memory>
+#include <vector>
+#include <utility>
+#include <cstdio>
+#include <cstdint>
+#include <algorithm>
+#include <stdexcept>
+
+#include <errno.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+#include <sdsl/int_vector.hpp>
+#include <sdsl/int_vector_buffer.hpp>
+#include <sdsl/int_vector_mapper.hpp>
+
+#include <parallel.hpp>
+
+namespace suffixient{
+
+// key of text[0..n-1], with symbols of symbol_bits bits, as a collection of
+// documents ended by separator if collection is set. Blocks of fixed size are
+// hashed in parallel and combined in order: the key does not depend on threads
+template<class t_text>
+std::string cache_key(const t_text& text, uint64_t n, uint8_t symbol_bits, uint32_t threads = 1,
+                      bool collection = false, uint8_t separator = 0)
+{
+  // splitmix64 finalizer
+  auto mix = [](uint64_t x){
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+    return x ^ (x >> 31);
+  };
+  auto rotl = [](uint64_t x, uint8_t r){ return (x << r) | (x >> (64 - r)); };
+
+  const uint64_t block = 1 << 20;
+  const uint64_t blocks = (n + block - 1) / block;
+  std::vector<std::pair<uint64_t,uint64_t>> h(blocks);
+  threads = std::max<uint64_t>(1, std::min<uint64_t>(threads, blocks));
+  parallel_for(threads, [&](uint64_t k){
+    for(uint64_t b = k; b < blocks; b += threads)
+    {
+      uint64_t h1 = b, h2 = ~b;
+      for(uint64_t i = b * block; i < std::min(n, (b + 1) * block); ++i)
+      {
+        uint64_t x = text[i];
+        h1 = rotl(h1 ^ x, 23) * 0x9e3779b97f4a7c15ULL;
+        h2 = rotl(h2 + x, 31) * 0xc2b2ae3d27d4eb4fULL;
+      }
+      h[b] = {mix(h1), mix(h2)};
+    }
+  });
+
+  // the arrays of a collection stop at its separators
+  uint64_t mode = collection ? (uint64_t(separator) + 1) << 8 : 0;
+  uint64_t k1 = mix(n), k2 = mix(n ^ symbol_bits ^ mode);
+  for(auto& x: h)
+  {
+    k1 = mix(k1 ^ x.first);
+    k2 = mix(k2 + x.second);
+  }
+  char key[33];
+  snprintf(key, sizeof(key), "%016llx%016llx", (unsigned long long)k1, (unsigned long long)k2);
+  return key;
+}
+
+class array_cache{
+public:
+
+  // arrays of key in directory dir, created if missing
+  array_cache(const std::string& dir, const std::string& key)
+    : sa_file(dir + "/" + key + ".sa"), lcp_file(dir + "/" + key + ".lcp")
+  {
+    if(mkdir(dir.c_str(), 0777) != 0 and errno != EEXIST)
+      throw std::runtime_error("mkdir() " + dir + " failed");
+  }
+
+  // map the cached SA and LCP arrays of n entries; false if they are not cached
+  template<uint8_t t_width>
+  bool map(uint64_t n, std::unique_ptr<sdsl::read_only_mapper<t_width>>& SA,
+           std::unique_ptr<sdsl::read_only_mapper<t_width>>& LCP) const
+  {
+    if(not exists(sa_file) or not exists(lcp_file))
+      return false;
+    SA.reset(new sdsl::read_only_mapper<t_width>(sa_file));
+    LCP.reset(new sdsl::read_only_mapper<t_width>(lcp_file));
+    if(SA->size() == n and LCP->size() == n)
+      return true;
+    SA.reset();
+    LCP.reset();
+    return false;
+  }
+
+  // store the SA and LCP arrays of n entries (not const: int_vector_buffer
+  // has no const access)
+  template<uint8_t t_width, class t_sa, class t_lcp>
+  void store(t_sa& SA, t_lcp& LCP, uint64_t n) const
+  {
+    // LCP first: map() needs both
+    write<t_width>(LCP, n, lcp_file);
+    write<t_width>(SA, n, sa_file);
+  }
+
+private:
+
+  std::string sa_file, lcp_file;
+
+  static bool exists(const std::string& path)
+  {
+    struct stat s;
+    return stat(path.c_str(), &s) == 0;
+  }
+
+  // write x[0..n-1] under a temporary name, then rename it to path
+  template<uint8_t t_width, class t_array>
+  static void write(t_array& x, uint64_t n, const std::string& path)
+  {
+    std::string tmp = path + ".tmp" + std::to_string(getpid());
+    save<t_width>(x, n, tmp);
+    if(rename(tmp.c_str(), path.c_str()) != 0)
+      throw std::runtime_error("rename() file " + tmp + " failed");
+  }
+
+  template<uint8_t t_width>
+  static void save(sdsl::int_vector<t_width>& x, uint64_t, const std::string& path)
+  {
+    if(not sdsl::store_to_file(x, path))
+      throw std::runtime_error("write file " + path + " failed");
+  }
+
+  // arrays not in RAM (sdsl cache) are streamed
+  template<uint8_t t_width, class t_array>
+  static void save(t_array& x, uint64_t n, const std::string& path)
+  {
+    sdsl::int_vector_buffer<t_width> out(path, std::ios::out);
+    for(uint64_t i = 0; i < n; ++i)
+      out.push_back(x[i]);
+  }
+};
+
+} // namespace suffixient
+
+#endif /* end of include guard: _SUFFIXIENT_ARRAY_CACHE_HH */
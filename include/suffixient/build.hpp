@@ -0,0 +1,258 @@
+// Copyright (c) 2026, REGINDEX.  All rights reserved.
+// Use of this source code is governed
+// by a MIT license that can be found in the LICENSE file.
+/*
+    Construction of the SA and LCP arrays of the reversed text. The
+    in-memory builders fill int_vector<t_width> arrays, with t_width = 32
+    or 40 bits chosen from the text length, without going through sdsl
+    cache files. With more than one thread the SA is built by libsais
+    (OpenMP), otherwise by divsufsort; texts over integer alphabets are
+    always sorted by libsais. The LCP array is computed either by
+    Kasai's algorithm or, using less memory, by the Phi algorithm, which
+    is also the one run on more threads.
+*/
+
+#ifndef _SUFFIXIENT_BUILD_HH
+#define _SUFFIXIENT_BUILD_HH
+
+#include <string>
+#include <limits>
+#include <stdexcept>
+
+#include <sdsl/construct.hpp>
+#include <sdsl/select_support.hpp>
+
+#include <divsufsort.h>
+#include <divsufsort64.h>
+#include <libsais.h>
+#include <libsais64.h>
+
+#include <parallel.hpp>
+
+namespace suffixient{
+
+// width of the SA, LCP, PSV and NSV entries for a text of length N
+// (entries store values up to N + 1)
+inline uint8_t index_width(uint64_t N)
+{
+  if(N + 1 <= std::numeric_limits<uint32_t>::max())
+    return 32;
+  if(N + 1 < (1ULL << 40))
+    return 40;
+  throw std::length_error("text longer than 2^40 - 2 symbols");
+}
+
+// libsais and divsufsort return 0 on success and a negative code on invalid
+// arguments or allocation failure
+inline void check_sa(int64_t code, const char* builder)
+{
+  if(code != 0)
+    throw std::runtime_error(std::string(builder) + " failed with code " + std::to_string(code));
+}
+
+// compute the SA of T (terminated by a unique 0x0) directly into SA
+template<uint8_t t_width>
+void build_sa(const sdsl::int_vector<8>& T, sdsl::int_vector<t_width>& SA, uint32_t threads = 1)
+{
+  uint64_t N = T.size();
+  const uint8_t* text = (const uint8_t*)T.data();
+
+  if(t_width == 32 and N <= uint64_t(std::numeric_limits<int32_t>::max()))
+  {
+    SA.resize(N);
+    if(threads > 1)
+      check_sa(libsais_omp(text, (int32_t*)SA.data(), N, 0, nullptr, threads), "libsais_omp");
+    else
+      check_sa(divsufsort(text, (saidx_t*)SA.data(), N), "divsufsort");
+    return;
+  }
+
+  // 64-bit construction, then narrowed to t_width bits
+  sdsl::int_vector<64> SA64(N);
+  if(threads > 1)
+    check_sa(libsais64_omp(text, (int64_t*)SA64.data(), N, 0, nullptr, threads), "libsais64_omp");
+  else
+    check_sa(divsufsort64(text, (saidx64_t*)SA64.data(), N), "divsufsort64");
+  SA.resize(N);
+  for(uint64_t i = 0; i < N; ++i)
+    SA[i] = SA64[i];
+}
+
+// compute the SA of T, over the integer alphabet [0,sigma) and terminated by a
+// unique 0, directly into SA. libsais permutes T during the construction and
+// restores it at the end.
+template<uint8_t t_width>
+void build_sa(sdsl::int_vector<32>& T, sdsl::int_vector<t_width>& SA, uint64_t sigma, uint32_t threads = 1)
+{
+  uint64_t N = T.size();
+
+  if(t_width == 32 and N <= uint64_t(std::numeric_limits<int32_t>::max())
+     and sigma <= uint64_t(std::numeric_limits<int32_t>::max()))
+  {
+    SA.resize(N);
+    int32_t* text = (int32_t*)T.data();
+    if(threads > 1)
+      check_sa(libsais_int_omp(text, (int32_t*)SA.data(), N, sigma, 0, threads), "libsais_int_omp");
+    else
+      check_sa(libsais_int(text, (int32_t*)SA.data(), N, sigma, 0), "libsais_int");
+    return;
+  }
+
+  // 64-bit construction, then narrowed to t_width bits
+  sdsl::int_vector<64> T64(N), SA64(N);
+  for(uint64_t i = 0; i < N; ++i)
+    T64[i] = T[i];
+  if(threads > 1)
+    check_sa(libsais64_long_omp((int64_t*)T64.data(), (int64_t*)SA64.data(), N, sigma, 0, threads),
+             "libsais64_long_omp");
+  else
+    check_sa(libsais64_long((int64_t*)T64.data(), (int64_t*)SA64.data(), N, sigma, 0), "libsais64_long");
+  T64 = sdsl::int_vector<64>();
+  SA.resize(N);
+  for(uint64_t i = 0; i < N; ++i)
+    SA[i] = SA64[i];
+}
+
+// compute the SA of the text stored under conf::KEY_TEXT and store it under conf::KEY_SA
+inline void build_sa(sdsl::cache_config& cc, uint32_t threads = 1)
+{
+  if(threads <= 1)
+  {
+    sdsl::construct_sa<8>(cc);
+    return;
+  }
+
+  sdsl::int_vector<8> T;
+  sdsl::load_from_cache(T, sdsl::conf::KEY_TEXT, cc);
+  uint64_t N = T.size();
+  const uint8_t* text = (const uint8_t*)T.data();
+
+  // stored bit-compressed, like sdsl's construct_sa
+  sdsl::int_vector<> SA;
+  if(N <= uint64_t(std::numeric_limits<int32_t>::max()))
+  {
+    SA = sdsl::int_vector<>(N, 0, 32);
+    check_sa(libsais_omp(text, (int32_t*)SA.data(), N, 0, nullptr, threads), "libsais_omp");
+  }
+  else
+  {
+    SA = sdsl::int_vector<>(N, 0, 64);
+    check_sa(libsais64_omp(text, (int64_t*)SA.data(), N, 0, nullptr, threads), "libsais64_omp");
+  }
+  T = sdsl::int_vector<8>();
+  sdsl::util::bit_compress(SA);
+  sdsl::store_to_cache(SA, sdsl::conf::KEY_SA, cc);
+}
+
+// compute the LCP array with Kasai's algorithm, using ISA as scratch space
+template<class t_text, class t_sa, class t_isa, class t_lcp>
+void build_lcp_kasai(const t_text& T, const t_sa& SA, t_isa& ISA, t_lcp& LCP)
+{
+  uint64_t N = SA.size();
+  ISA.resize(N);
+  LCP.resize(N);
+
+  for(uint64_t i = 0; i < N; ++i)
+    ISA[SA[i]] = i;
+
+  LCP[0] = 0;
+  uint64_t h = 0;
+  for(uint64_t i = 0; i < N; ++i)
+  {
+    uint64_t r = ISA[i];
+    if(r > 0)
+    {
+      uint64_t j = SA[r - 1];
+      // the unique terminator stops the comparison before the end of T; in a
+      // collection, the separators (0x0 as well) end the common prefix
+      while(T[i + h] == T[j + h] and T[i + h] != 0) ++h;
+      LCP[r] = h;
+      if(h > 0) --h;
+    }
+    else
+      h = 0;
+  }
+}
+
+/*
+ * compute the LCP array with the Phi algorithm (Karkkainen, Manzini and
+ * Puglisi, CPM 2009). Phi is stored in LCP itself; the permuted LCP is
+ * kept in 2N bits while LCP is rewritten in SA order: peak memory is
+ * text + SA + LCP + ~2.2N bits, one array less than build_lcp_kasai.
+ * With more than one thread each phase is split in blocks: PLCP is
+ * computed over segments of the text, each starting from h = 0.
+ */
+template<class t_text, class t_sa, class t_lcp>
+void build_lcp_phi(const t_text& T, const t_sa& SA, t_lcp& LCP, uint32_t threads = 1)
+{
+  uint64_t N = SA.size();
+  uint64_t first = SA[0]; // the suffix with no predecessor
+  LCP.resize(N);
+
+  // Phi[SA[i]] = SA[i-1]
+  if(threads <= 1)
+    for(uint64_t i = 1; i < N; ++i)
+      LCP[SA[i]] = SA[i - 1];
+  else
+  {
+    sdsl::util::set_to_value(LCP, 0);
+    parallel_blocks(N, threads, 1, [&](uint64_t b, uint64_t e){
+      for(uint64_t i = std::max<uint64_t>(b, 1); i < e; ++i)
+        atomic_or(LCP, SA[i], SA[i - 1]);
+    });
+  }
+
+  // PLCP[i] + i is non-decreasing: PLCP[i] is encoded by a one at PLCP[i] + 2i
+  sdsl::bit_vector H(2 * N, 0);
+  parallel_blocks(N, threads, 1, [&](uint64_t b, uint64_t e){
+    uint64_t h = 0;
+    for(uint64_t i = b; i < e; ++i)
+    {
+      uint64_t j = LCP[i];
+      if(i == first)
+        h = 0;
+      else
+        // the unique terminator stops the comparison before the end of T; in a
+        // collection, the separators (0x0 as well) end the common prefix
+        while(T[i + h] == T[j + h] and T[i + h] != 0) ++h;
+      if(threads <= 1)
+        H[h + 2 * i] = 1;
+      else
+        atomic_or(H, h + 2 * i, 1);
+      if(h > 0) --h;
+    }
+  });
+
+  sdsl::select_support_mcl<1> select(&H);
+  parallel_blocks(N, threads, 64, [&](uint64_t b, uint64_t e){
+    for(uint64_t i = b; i < e; ++i)
+      LCP[i] = select(SA[i] + 1) - 2 * SA[i];
+  });
+}
+
+// compute the LCP array of the text and SA stored under conf::KEY_TEXT and
+// conf::KEY_SA with the Phi algorithm, and store it under conf::KEY_LCP
+inline void build_lcp_phi(sdsl::cache_config& cc, uint32_t threads = 1)
+{
+  if(threads <= 1)
+  {
+    sdsl::construct_lcp_PHI<8>(cc);
+    return;
+  }
+
+  sdsl::int_vector<8> T;
+  sdsl::int_vector<> SA;
+  sdsl::load_from_cache(T, sdsl::conf::KEY_TEXT, cc);
+  sdsl::load_from_cache(SA, sdsl::conf::KEY_SA, cc);
+
+  // LCP values are smaller than N, as SA values
+  sdsl::int_vector<> LCP(0, 0, SA.width());
+  build_lcp_phi(T, SA, LCP, threads);
+  T = sdsl::int_vector<8>();
+  SA = sdsl::int_vector<>();
+  sdsl::store_to_cache(LCP, sdsl::conf::KEY_LCP, cc);
+}
+
+} // namespace suffixient
+
+#endif /* end of include guard: _SUFFIXIENT_BUILD_HH */
@@ -0,0 +1,65 @@
+// Copyright (c) 2026, REGINDEX.  All rights reserved.
+// Use of this source code is governed
+// by a MIT license that can be found in the LICENSE file.
+/*
+    Documents of a string collection given as one text, with the
+    documents separated by a separator character. Positions of the text
+    are translated to (document, offset) pairs: documents are numbered
+    from 0 in order of appearance, and offsets are 1-based end positions
+    within the document, as the positions of the suffixient set of a
+    single text.
+*/
+
+#ifndef _SUFFIXIENT_COLLECTION_HH
+#define _SUFFIXIENT_COLLECTION_HH
+
+#include <vector>
+#include <utility>
+#include <cstdint>
+#include <algorithm>
+
+#include <parallel.hpp>
+
+namespace suffixient{
+
+class documents{
+public:
+
+  documents(const char* text, uint64_t n_, uint8_t separator, uint32_t threads = 1) : n(n_)
+  {
+    threads = std::max<uint32_t>(1, std::min<uint64_t>(threads, n / (1 << 16) + 1));
+    uint64_t block = (n + threads - 1) / threads;
+
+    // separators of each block, then concatenated in order
+    std::vector<std::vector<uint64_t>> found(threads);
+    parallel_for(threads, [&](uint64_t k){
+      for(uint64_t i = k * block; i < std::min(n, (k + 1) * block); ++i)
+        if(uint8_t(text[i]) == separator)
+          found[k].push_back(i + 1);
+    });
+
+    starts.push_back(0);
+    for(auto& f: found)
+      starts.insert(starts.end(), f.begin(), f.end());
+  }
+
+  // (document, offset) of the 1-based position x of the text
+  std::pair<uint64_t,uint64_t> locate(uint64_t x) const
+  {
+    uint64_t d = std::upper_bound(starts.begin(), starts.end(), x - 1) - starts.begin() - 1;
+    return {d, x - starts[d]};
+  }
+
+  // number of documents (a trailing separator ends the last one)
+  uint64_t size() const { return starts.size() - (starts.size() > 1 and starts.back() == n); }
+
+private:
+
+  uint64_t n;
+
+  std::vector<uint64_t> starts;  // position of the first character of each document
+};
+
+} // namespace suffixient
+
+#endif /* end of include guard: _SUFFIXIENT_COLLECTION_HH */
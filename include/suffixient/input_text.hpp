@@ -0,0 +1,98 @@
+// Copyright (c) 2026, REGINDEX.  All rights reserved.
+// Use of this source code is governed
+// by a MIT license that can be found in the LICENSE file.
+/*
+    Input text of the tools: either read from standard input or mapped
+    in memory from a file, with no copy. In both cases the text ends
+    before the first occurrence of 0x0, unless it is binary (the symbols
+    of an integer alphabet), in which case it is read whole.
+*/
+
+#ifndef _SUFFIXIENT_INPUT_TEXT_HH
+#define _SUFFIXIENT_INPUT_TEXT_HH
+
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <cstring>
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+namespace suffixient{
+
+class input_text{
+public:
+
+  // an empty path reads standard input, otherwise the file is mapped with mmap
+  input_text(const std::string& path, bool binary = false)
+  {
+    if(path.length() == 0)
+    {
+      if(binary)
+        in.assign(std::istreambuf_iterator<char>(std::cin), std::istreambuf_iterator<char>());
+      else
+        std::getline(std::cin,in,char(0));
+      text = in.data();
+      n = in.size();
+      return;
+    }
+
+    int fd = open(path.c_str(), O_RDONLY);
+    if(fd < 0)
+      throw std::runtime_error("open() file " + path + " failed");
+
+    struct stat st;
+    if(fstat(fd, &st) != 0)
+    {
+      close(fd);
+      throw std::runtime_error("stat() file " + path + " failed");
+    }
+
+    length = st.st_size;
+    if(length > 0)
+    {
+      void *p = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+      if(p == MAP_FAILED)
+      {
+        close(fd);
+        throw std::runtime_error("mmap() file " + path + " failed");
+      }
+      // the text is read once, backwards: prefetch it all
+      madvise(p, length, MADV_WILLNEED);
+      map = p;
+      text = (const char*)map;
+      const void *zero = binary ? nullptr : memchr(text, 0, length);
+      n = zero == nullptr ? length : (const char*)zero - text;
+    }
+    close(fd);
+  }
+
+  ~input_text()
+  {
+    if(map != nullptr)
+      munmap(map, length);
+  }
+
+  input_text(const input_text&) = delete;
+  input_text& operator=(const input_text&) = delete;
+
+  const char* data() const { return text; }
+
+  uint64_t size() const { return n; }
+
+private:
+
+  std::string in;          // standard input
+  void *map = nullptr;     // mapped file
+  uint64_t length = 0;     // size of the mapping
+  const char *text = nullptr;
+  uint64_t n = 0;
+};
+
+} // namespace suffixient
+
+#endif /* end of include guard: _SUFFIXIENT_INPUT_TEXT_HH */
@@ -0,0 +1,148 @@
+// Copyright (c) 2026, REGINDEX.  All rights reserved.
+// Use of this source code is governed
+// by a MIT license that can be found in the LICENSE file.
+/*
+    Candidates of the one_pass scan, evaluated without a sweep over the
+    alphabet at each BWT run boundary. eval(m) expires every candidate
+    longer than m and shortens it to m; a candidate set right after an
+    evaluation is never shorter than its threshold. Hence the candidates
+    form a stack of non-decreasing length: eval(m) pops the longer ones and
+    merges them into a single group of length m (union-find), touching only
+    the candidates that actually expire.
+*/
+
+#ifndef _SUFFIXIENT_MAXIMA_STACK_HH
+#define _SUFFIXIENT_MAXIMA_STACK_HH
+
+#include <vector>
+#include <utility>
+#include <cstdint>
+#include <algorithm>
+
+namespace suffixient{
+
+class maxima_stack{
+public:
+
+  // all characters start with no candidate (length -1)
+  void reset(uint64_t sigma)
+  {
+    nodes.assign(1, {-1, 0, 0, 0, false});
+    group.assign(sigma, 0);
+    stack.assign(1, 0);
+    zero = {-1, 0, 0, 0, false};
+  }
+
+  // length of the candidate of character c
+  int64_t len(uint64_t c)
+  {
+    return c == 0 ? zero.len : nodes[find(group[c])].len;
+  }
+
+  // make (l,pos) the active candidate of c; l must not be smaller than
+  // the threshold of the last evaluation
+  void set(uint64_t c, int64_t l, uint64_t pos)
+  {
+    if(c == 0)
+    {
+      zero = {l, pos, 0, 0, true};
+      return;
+    }
+    if(nodes.size() >= 2 * group.size() + 16)
+      compact();
+    group[c] = nodes.size();
+    stack.push_back(nodes.size());
+    nodes.push_back({l, pos, nodes.size(), c, true});
+  }
+
+  // evaluate all candidates with threshold m: output the active ones longer
+  // than m in increasing character order, then shorten them to m.
+  // Character 0 is never evaluated.
+  template<class t_out>
+  void eval(int64_t m, t_out& out)
+  {
+    if(stack.empty() or nodes[stack.back()].len <= m)
+      return;
+
+    expired.clear();
+    uint64_t root = stack.back();
+    while(not stack.empty() and nodes[stack.back()].len > m)
+    {
+      node& x = nodes[stack.back()];
+      // a candidate replaced by a later set is stale
+      if(x.active and group[x.c] == stack.back())
+        expired.push_back({x.c, x.pos});
+      x.active = false;
+      x.parent = root;
+      stack.pop_back();
+    }
+    nodes[root].len = m;
+    stack.push_back(root);
+
+    std::sort(expired.begin(), expired.end());
+    for(auto& e: expired)
+      out(e.second);
+  }
+
+private:
+
+  struct node{
+    int64_t len;
+    uint64_t pos;
+    uint64_t parent;
+    uint64_t c;      // character of a candidate set by set()
+    bool active;
+  };
+
+  std::vector<node> nodes;
+  std::vector<uint64_t> group;  // node of each character
+  std::vector<uint64_t> stack;  // group roots, by non-decreasing length
+  std::vector<std::pair<uint64_t,uint64_t>> expired;
+  node zero;                    // candidate of character 0
+
+  uint64_t find(uint64_t x)
+  {
+    uint64_t r = x;
+    while(nodes[r].parent != r)
+      r = nodes[r].parent;
+    while(nodes[x].parent != r)
+    {
+      uint64_t next = nodes[x].parent;
+      nodes[x].parent = r;
+      x = next;
+    }
+    return r;
+  }
+
+  // drop the nodes no character points to
+  void compact()
+  {
+    std::vector<bool> used(nodes.size(), false);
+    for(uint64_t c = 1; c < group.size(); ++c)
+    {
+      group[c] = find(group[c]);
+      used[group[c]] = true;
+    }
+
+    std::vector<uint64_t> id(nodes.size(), 0);
+    std::vector<node> kept;
+    std::vector<uint64_t> kept_stack;
+    for(auto r: stack)
+      if(used[r])
+      {
+        id[r] = kept.size();
+        kept_stack.push_back(kept.size());
+        kept.push_back(nodes[r]);
+        kept.back().parent = id[r];
+      }
+
+    for(uint64_t c = 1; c < group.size(); ++c)
+      group[c] = id[group[c]];
+    nodes.swap(kept);
+    stack.swap(kept_stack);
+  }
+};
+
+} // namespace suffixient
+
+#endif /* end of include guard: _SUFFIXIENT_MAXIMA_STACK_HH */
@@ -0,0 +1,119 @@
+// Copyright (c) 2026, REGINDEX.  All rights reserved.
+// Use of this source code is governed
+// by a MIT license that can be found in the LICENSE file.
+/*
+    Online engine maintaining a smallest suffixient set of a text that
+    grows by appending characters. The text is kept as its directed
+    acyclic word graph (suffix automaton), built online by Blumer et
+    al.'s algorithm: the suffix-link tree of the automaton of T is the
+    suffix tree of T^rev, so each appended character is a Weiner left
+    extension of the suffix tree of T^rev used by the other engines.
+
+    A state q groups the substrings of T with the same end positions;
+    its longest string a is right-maximal when q has at least two out
+    edges, counting the end of the text as one. The extension a.c of a
+    right-maximal a is supermaximal if no child p of q in the suffix-link
+    tree (the states of the strings x.a) is right-maximal with an edge
+    labeled c, and the set holds one end position of a.c for each
+    supermaximal extension.
+
+    The end of the text moves with every character, so it is left out of
+    the maintained state: a state is marked right-maximal when it has two
+    edges, each edge keeps the number of such children with an edge
+    labeled c, and selects a.c when it has none. Appending a batch of k
+    characters thus costs O(k) amortized automaton updates, each visiting
+    the edges of the states involved. The end of the text only extends
+    the states on the suffix-link path of the last state, the suffixes of
+    T: size() and scan() walk that path and correct the selection of its
+    edges, where a state with a single edge is right-maximal as well.
+    The automaton has at most 2n states and 3n edges.
+*/
+
+#ifndef _SUFFIXIENT_ONLINE_HH
+#define _SUFFIXIENT_ONLINE_HH
+
+#include <vector>
+#include <functional>
+#include <cstdint>
+
+namespace suffixient{
+
+class online_engine{
+public:
+
+  online_engine();
+
+  // append text[0..n-1] to the text, updating the suffixient set
+  void append(const char* text, uint64_t n);
+
+  // stream the suffixient set of the current text to out (1-based end
+  // positions, as the other engines)
+  void scan(const std::function<void(uint64_t)>& out) const;
+
+  // store the suffixient set of the current text in S
+  void set(std::vector<uint64_t>& S) const;
+
+  // size of the suffixient set of the current text, in time proportional to
+  // the edges on the suffix-link path of the last state
+  uint64_t size() const;
+
+  // length of the current text
+  uint64_t length() const { return n; }
+
+  // number of states of the automaton
+  uint64_t states() const { return st.size(); }
+
+private:
+
+  struct edge{
+    uint64_t target;
+    uint32_t cover;  // children of the source marked rm with an edge labeled c
+    uint8_t c;
+    bool selected;   // supermaximal extension, without the end of the text
+  };
+
+  struct state{
+    uint64_t len;       // length of the longest string
+    int64_t link;       // suffix link, -1 for the root
+    uint64_t firstpos;  // end position of the first occurrence
+    bool rm;            // two edges or more, as counted in the cover of the parent
+    std::vector<edge> edges;
+  };
+
+  std::vector<state> st;
+  uint64_t last = 0;  // state of the whole text
+  uint64_t n = 0;
+  uint64_t chi = 0;  // selected edges, without the end of the text
+
+  std::vector<uint64_t> path;  // states gaining an edge in extend
+
+  // append character c
+  void extend(uint8_t c);
+
+  // edge of q labeled c, nullptr if none
+  edge* find(uint64_t q, uint8_t c);
+
+  // add the edge q -c-> target
+  void add_edge(uint64_t q, uint8_t c, uint64_t target);
+
+  // move p under parent in the suffix-link tree
+  void set_link(uint64_t p, int64_t parent);
+
+  // recompute whether q is right-maximal, updating the covers of its parent
+  void refresh(uint64_t q);
+
+  // add sign to the covers of the parent of the right-maximal p
+  void attach(uint64_t p, int sign);
+
+  // select or deselect the extension e of q
+  void evaluate(uint64_t q, edge& e);
+
+  // whether the extension e of the state q on the suffix-link path of last is
+  // supermaximal in the current text, child being the state below q on the
+  // path (-1 for last)
+  bool supermaximal(uint64_t q, const edge& e, int64_t child) const;
+};
+
+} // namespace suffixient
+
+#endif /* end of include guard: _SUFFIXIENT_ONLINE_HH */
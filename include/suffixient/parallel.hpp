@@ -0,0 +1,59 @@
+// Copyright (c) 2026, REGINDEX.  All rights reserved.
+// Use of this source code is governed
+// by a MIT license that can be found in the LICENSE file.
+/*
+    Threading helpers shared by the parallel construction and scan.
+*/
+
+#ifndef _SUFFIXIENT_PARALLEL_HH
+#define _SUFFIXIENT_PARALLEL_HH
+
+#include <vector>
+#include <thread>
+#include <cstdint>
+#include <algorithm>
+
+namespace suffixient{
+
+// run f(0), ..., f(n-1) on n threads
+template<class t_fun>
+void parallel_for(uint64_t n, const t_fun& f)
+{
+  std::vector<std::thread> workers;
+  for(uint64_t k = 1; k < n; ++k)
+    workers.emplace_back(f, k);
+  f(0);
+  for(auto& t: workers)
+    t.join();
+}
+
+// run f(b,e) on the blocks [b,e) of [0,n), one per thread; block boundaries
+// are multiples of align, so that blocks of an int_vector share no word when
+// align * width is a multiple of 64
+template<class t_fun>
+void parallel_blocks(uint64_t n, uint64_t threads, uint64_t align, const t_fun& f)
+{
+  uint64_t block = (n + threads - 1) / threads;
+  block = (block + align - 1) / align * align;
+  parallel_for(threads, [&](uint64_t k){
+    uint64_t b = std::min(n, k * block), e = std::min(n, b + block);
+    if(b < e) f(b, e);
+  });
+}
+
+// OR x into entry i of an int_vector, atomically with respect to concurrent
+// writes of other entries sharing its 64-bit words
+template<class t_iv>
+inline void atomic_or(t_iv& v, uint64_t i, uint64_t x)
+{
+  uint64_t *data = v.data();
+  uint8_t w = v.width();
+  uint64_t bit = i * w, word = bit >> 6, off = bit & 63;
+  __atomic_fetch_or(data + word, x << off, __ATOMIC_RELAXED);
+  if(off + w > 64)
+    __atomic_fetch_or(data + word + 1, x >> (64 - off), __ATOMIC_RELAXED);
+}
+
+} // namespace suffixient
+
+#endif /* end of include guard: _SUFFIXIENT_PARALLEL_HH */
@@ -0,0 +1,358 @@
+// Copyright (c) 2026, REGINDEX.  All rights reserved.
+// Use of this source code is governed
+// by a MIT license that can be found in the LICENSE file.
+/*
+    Multithreaded version of linear_time_scan. The SA range is split in
+    chunks, each scanned by its own thread starting from an unknown
+    candidate state for every character. Until the candidate of a character
+    is fixed by the chunk itself, the operations on it are recorded (the
+    per-character boundary summary); afterwards they are applied locally,
+    and the candidates closed in the chunk are collected as local output.
+    A sequential merge replays the summaries on the real state and
+    interleaves both outputs, so that the set is emitted in exactly the
+    order of the sequential scan. The state of a chunk is indexed by the
+    symbols it contains, so that its size and the cost of the merge do not
+    grow with the alphabet (integer alphabets).
+*/
+
+#ifndef _SUFFIXIENT_PARALLEL_SCAN_HH
+#define _SUFFIXIENT_PARALLEL_SCAN_HH
+
+#include <vector>
+#include <limits>
+#include <algorithm>
+#include <unordered_map>
+
+#include <sdsl/int_vector.hpp>
+
+#include <scan.hpp>
+#include <parallel.hpp>
+
+namespace suffixient{
+
+// operation on the candidate of character c, recorded while its state is unknown
+struct candidate_op{
+  enum type_t : uint8_t { EVAL, EVAL_IF_SET, SET };
+  uint64_t tag;  // 2*i for the run before boundary i, 2*i+1 for the run after it
+  int64_t x;     // threshold of EVAL/EVAL_IF_SET, new length of SET
+  uint64_t pos;  // text position of SET
+  uint32_t c;
+  type_t type;
+};
+
+// element of the suffixient set, tagged with the scan step emitting it
+struct tagged_pos{
+  uint64_t tag;
+  uint64_t pos;
+};
+
+// symbols buffered by the chunks: bytes, or integers of an integer alphabet
+template<class t_text> struct chunk_symbol{ typedef uint32_t type; };
+template<> struct chunk_symbol<sdsl::int_vector<8>>{ typedef uint8_t type; };
+
+// ids 0,1,...,d-1 of the d distinct symbols met, in order of first occurrence
+template<class t_char>
+class symbol_ids{
+public:
+
+  std::vector<t_char> symbols;  // symbol of each id
+
+  t_char operator()(t_char c)
+  {
+    auto r = id.emplace(c, t_char(symbols.size()));
+    if(r.second)
+      symbols.push_back(c);
+    return r.first->second;
+  }
+
+  void clear()
+  {
+    id.clear();
+    symbols.clear();
+  }
+
+private:
+
+  std::unordered_map<t_char,t_char> id;
+};
+
+// bytes: a table of 256 entries, of which clear() resets only those in use
+template<>
+class symbol_ids<uint8_t>{
+public:
+
+  std::vector<uint8_t> symbols;
+
+  symbol_ids() { std::fill(id, id + 256, none); }
+
+  uint8_t operator()(uint8_t c)
+  {
+    if(id[c] == none)
+    {
+      id[c] = symbols.size();
+      symbols.push_back(c);
+    }
+    return id[c];
+  }
+
+  void clear()
+  {
+    for(auto c: symbols)
+      id[c] = none;
+    symbols.clear();
+  }
+
+private:
+
+  static const uint16_t none = 256;
+  uint16_t id[256];
+};
+
+// the arrays of a chunk are indexed by the ids of its symbols, BWT[b-1] included
+template<class t_char>
+struct scan_chunk{
+  uint64_t b = 0, e = 0;        // SA positions [b,e)
+  symbol_ids<t_char> ids;
+  std::vector<t_char> bwt;      // ids of BWT[b..e-1]
+  t_char prev = 0;              // id of BWT[b-1]
+  std::vector<uint64_t> occ;    // occurrences of each symbol in BWT[b..e-1]
+  std::vector<uint64_t> ptr;    // pointers (LF) of each symbol at the start of the chunk
+  bool boundary = false;        // the chunk contains a run boundary
+  int64_t min_all, min_tail;    // min LCP of the chunk and after its last boundary
+  int64_t m_in;                 // min LCP since the last boundary before the chunk
+  uint64_t runs = 0;
+
+  std::vector<candidate_op> ops;
+  std::vector<tagged_pos> local;
+  std::vector<uint8_t> known;
+  std::vector<lcp_maxima> state;
+};
+
+template<class t_out>
+inline void eval(int64_t m, lcp_maxima& R, uint64_t tag, t_out& out)
+{
+  if(m < R.len)
+  {
+    if(R.active)
+      out(tagged_pos{tag, R.pos});
+    R = {m,0,false};
+  }
+}
+
+/*
+ * same output, in the same order, as linear_time_scan; SA, LCP and T must
+ * support concurrent reads. Returns the number of equal-letter BWT runs.
+ */
+template<class t_text, class t_sa, class t_lcp, class t_out>
+uint64_t linear_time_scan_parallel(const t_text& T, t_sa& SA, const t_lcp& LCP, uint64_t N,
+                                   uint64_t sigma, uint64_t threads, t_out& out,
+                                   uint64_t chunk_size = 1ULL << 22)
+{
+  typedef typename chunk_symbol<t_text>::type t_char;
+  const int64_t inf = std::numeric_limits<int64_t>::max();
+  uint64_t bwtruns = 1;
+
+  chunk_size = std::max<uint64_t>(1, std::min(chunk_size, (N + threads - 1) / threads));
+
+  // pointers start at C[c], the first SA position of suffixes starting with c
+  std::vector<scan_chunk<t_char>> chunks(threads);
+  std::vector<uint64_t> ptr(sigma, 0);
+  {
+    uint64_t part = (N + threads - 1) / threads;
+    parallel_for(threads, [&](uint64_t k){
+      auto& ch = chunks[k];
+      ch.ids.clear();
+      ch.occ.clear();
+      for(uint64_t j = k * part; j < std::min(N, (k + 1) * part); ++j)
+      {
+        t_char c = ch.ids(T[j]);
+        if(c == ch.occ.size())
+          ch.occ.push_back(0);
+        ch.occ[c]++;
+      }
+    });
+    for(auto& ch: chunks)
+      for(uint64_t c = 0; c < ch.occ.size(); ++c)
+        ptr[ch.ids.symbols[c]] += ch.occ[c];
+    uint64_t sum = 0;
+    for(uint64_t c = 0; c < sigma; ++c)
+    {
+      uint64_t occ = ptr[c];
+      ptr[c] = sum;
+      sum += occ;
+    }
+  }
+
+  std::vector<lcp_maxima> R(sigma, {-1,0,false});
+  std::vector<tagged_pos> prefix;
+  int64_t m = inf;
+
+  for(uint64_t b = 0; b < N; b += threads * chunk_size)
+  {
+    uint64_t n_chunks = std::min(threads, (N - b + chunk_size - 1) / chunk_size);
+
+    for(uint64_t k = 0; k < n_chunks; ++k)
+    {
+      chunks[k].b = b + k * chunk_size;
+      chunks[k].e = std::min(N, chunks[k].b + chunk_size);
+    }
+
+    // pass 1: BWT, character occurrences and LCP minima of each chunk
+    parallel_for(n_chunks, [&](uint64_t k){
+      auto& ch = chunks[k];
+      ch.bwt.resize(ch.e - ch.b);
+      ch.ids.clear();
+      ch.occ.clear();
+      ch.prev = ch.ids(ch.b > 0 ? BWT(T,SA,ch.b - 1) : 0);
+      ch.occ.push_back(0);
+      ch.boundary = false;
+      ch.min_all = ch.min_tail = inf;
+
+      t_char p = ch.prev;
+      for(uint64_t i = ch.b; i < ch.e; ++i)
+      {
+        t_char c = ch.ids(BWT(T,SA,i));
+        if(c == ch.occ.size())
+          ch.occ.push_back(0);
+        ch.bwt[i - ch.b] = c;
+        ch.occ[c]++;
+        if(i == 0) { p = c; continue; }
+
+        int64_t l = LCP[i];
+        ch.min_all = std::min(ch.min_all, l);
+        ch.min_tail = std::min(ch.min_tail, l);
+        if(c != p)
+        {
+          ch.boundary = true;
+          ch.min_tail = inf;
+        }
+        p = c;
+      }
+    });
+
+    // resolve pointers and running LCP minimum at the start of each chunk
+    for(uint64_t k = 0; k < n_chunks; ++k)
+    {
+      auto& ch = chunks[k];
+      ch.ptr.resize(ch.occ.size());
+      for(uint64_t c = 0; c < ch.occ.size(); ++c)
+      {
+        ch.ptr[c] = ptr[ch.ids.symbols[c]];
+        ptr[ch.ids.symbols[c]] += ch.occ[c];
+      }
+      ch.m_in = m;
+      m = ch.boundary ? ch.min_tail : std::min(m, ch.min_all);
+    }
+
+    // pass 2: scan each chunk from an unknown candidate state
+    parallel_for(n_chunks, [&](uint64_t k){
+      auto& ch = chunks[k];
+      ch.ops.clear();
+      ch.local.clear();
+      ch.known.assign(ch.occ.size(), 0);
+      ch.state.assign(ch.occ.size(), {-1,0,false});
+      ch.runs = 0;
+
+      auto local = [&ch](tagged_pos x){ ch.local.push_back(x); };
+      const auto& symbol = ch.ids.symbols;
+      int64_t m = ch.m_in;
+      t_char p = ch.prev;
+
+      for(uint64_t i = ch.b; i < ch.e; ++i)
+      {
+        t_char c = ch.bwt[i - ch.b];
+        ch.ptr[c]++;
+        if(i == 0) { p = c; continue; }
+
+        int64_t l = LCP[i];
+        m = std::min(m, l);
+
+        if(c != p)
+        {
+          // the character 0 never holds a candidate
+          if(symbol[p] != 0)
+          {
+            if(ch.known[p])
+            {
+              eval(m, ch.state[p], 2*i, local);
+              if(l > ch.state[p].len)
+                ch.state[p] = {l, N - SA[i-1], true};
+            }
+            else
+            {
+              ch.ops.push_back({2*i, m, 0, symbol[p], candidate_op::EVAL});
+              // after eval(m), a longer l always replaces the candidate
+              if(l > m)
+              {
+                ch.known[p] = 1;
+                ch.state[p] = {l, N - SA[i-1], true};
+              }
+              else
+                ch.ops.push_back({2*i, l, N - SA[i-1], symbol[p], candidate_op::SET});
+            }
+          }
+          if(symbol[c] != 0)
+          {
+            int64_t x = int64_t(LCP[ch.ptr[c] - 1]) - 1;
+            if(ch.known[c])
+            {
+              if(ch.state[c].len != -1)
+                eval(x, ch.state[c], 2*i + 1, local);
+              if(l > ch.state[c].len)
+                ch.state[c] = {l, N - SA[i], true};
+            }
+            else
+            {
+              ch.ops.push_back({2*i + 1, x, 0, symbol[c], candidate_op::EVAL_IF_SET});
+              ch.ops.push_back({2*i + 1, l, N - SA[i], symbol[c], candidate_op::SET});
+            }
+          }
+          m = std::numeric_limits<int64_t>::max();
+          ch.runs++;
+        }
+        p = c;
+      }
+    });
+
+    // merge: replay the summaries on the real state, then output in scan order
+    auto to_prefix = [&prefix](tagged_pos x){ prefix.push_back(x); };
+    for(uint64_t k = 0; k < n_chunks; ++k)
+    {
+      auto& ch = chunks[k];
+      prefix.clear();
+      for(auto& op: ch.ops)
+      {
+        lcp_maxima& r = R[op.c];
+        if(op.type == candidate_op::SET)
+        {
+          if(op.x > r.len)
+            r = {op.x, op.pos, true};
+        }
+        else if(op.type == candidate_op::EVAL or r.len != -1)
+          eval(op.x, r, op.tag, to_prefix);
+      }
+      for(uint64_t c = 0; c < ch.known.size(); ++c)
+        if(ch.known[c])
+          R[ch.ids.symbols[c]] = ch.state[c];
+
+      auto a = prefix.begin(), z = ch.local.begin();
+      while(a != prefix.end() or z != ch.local.end())
+        if(z == ch.local.end() or (a != prefix.end() and a->tag < z->tag))
+          out((a++)->pos);
+        else
+          out((z++)->pos);
+
+      bwtruns += ch.runs;
+    }
+  }
+
+  // evaluate last active candidates
+  for(uint64_t c = 1; c < sigma; ++c)
+    eval(c,-1,R,out);
+
+  return bwtruns;
+}
+
+} // namespace suffixient
+
+#endif /* end of include guard: _SUFFIXIENT_PARALLEL_SCAN_HH */
@@ -0,0 +1,81 @@
+// Copyright (c) 2026, REGINDEX.  All rights reserved.
+// Use of this source code is governed
+// by a MIT license that can be found in the LICENSE file.
+/*
+    Parallel least-significant-digit radix sort of 64-bit integers, on
+    8-bit digits. Only the digits below the largest value are sorted,
+    and a digit shared by all the values is skipped. Each pass counts
+    the digits of one block per thread, then scatters the blocks
+    concurrently into disjoint ranges of a buffer of the same size.
+*/
+
+#ifndef _SUFFIXIENT_RADIX_SORT_HH
+#define _SUFFIXIENT_RADIX_SORT_HH
+
+#include <vector>
+#include <array>
+#include <cstdint>
+#include <algorithm>
+
+#include <parallel.hpp>
+
+namespace suffixient{
+
+inline void radix_sort(std::vector<uint64_t>& v, uint32_t threads = 1)
+{
+  const uint64_t n = v.size();
+  // below this size a comparison sort is faster than the passes
+  if(n < (1 << 16))
+  {
+    std::sort(v.begin(), v.end());
+    return;
+  }
+
+  uint64_t max = *std::max_element(v.begin(), v.end());
+  uint8_t digits = 0;
+  for(; max > 0; max >>= 8)
+    ++digits;
+
+  threads = std::max<uint64_t>(1, std::min<uint64_t>(threads, n >> 16));
+  const uint64_t block = (n + threads - 1) / threads;
+  std::vector<std::array<uint64_t, 256>> count(threads);
+  std::vector<uint64_t> tmp(n);
+
+  for(uint8_t d = 0; d < digits; ++d)
+  {
+    const uint8_t shift = 8 * d;
+
+    parallel_for(threads, [&](uint64_t k){
+      count[k].fill(0);
+      for(uint64_t i = k * block; i < std::min(n, (k + 1) * block); ++i)
+        count[k][(v[i] >> shift) & 0xff]++;
+    });
+
+    // first destination of each digit in each block: digits in order, then blocks
+    uint64_t sum = 0;
+    bool skip = false;
+    for(uint64_t c = 0; c < 256; ++c)
+    {
+      uint64_t before = sum;
+      for(uint64_t k = 0; k < threads; ++k)
+      {
+        uint64_t t = count[k][c];
+        count[k][c] = sum;
+        sum += t;
+      }
+      skip = skip or sum - before == n;
+    }
+    if(skip)
+      continue;
+
+    parallel_for(threads, [&](uint64_t k){
+      for(uint64_t i = k * block; i < std::min(n, (k + 1) * block); ++i)
+        tmp[count[k][(v[i] >> shift) & 0xff]++] = v[i];
+    });
+    v.swap(tmp);
+  }
+}
+
+} // namespace suffixient
+
+#endif /* end of include guard: _SUFFIXIENT_RADIX_SORT_HH */
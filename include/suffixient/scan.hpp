@@ -0,0 +1,334 @@
+// Copyright (c) 2026, REGINDEX.  All rights reserved.
+// Use of this source code is governed
+// by a MIT license that can be found in the LICENSE file.
+/*
+    Scans computing a smallest suffixient set from the SA and LCP arrays
+    of the reversed text. Each scan is a template over the text, SA and
+    LCP containers and over the output sink, which is called once per
+    element of the suffixient set.
+*/
+
+#ifndef _SUFFIXIENT_SCAN_HH
+#define _SUFFIXIENT_SCAN_HH
+
+#include <vector>
+#include <limits>
+#include <cstdint>
+
+#include <maxima_stack.hpp>
+
+namespace suffixient{
+
+// candidate suffixient right-extension (linear_time and one_pass)
+struct lcp_maxima{
+  int64_t len;
+  uint64_t pos;
+  bool active;
+};
+
+// candidate suffixient right-extension (lc, plain_lc and fm)
+struct lcp_candidate{
+  int64_t sa_pos;
+  uint64_t text_pos;
+  bool candidate;
+  int64_t nsv;
+};
+
+template<class t_text, class t_sa>
+inline uint64_t BWT(const t_text& T, t_sa& SA, uint64_t i)
+{
+  uint64_t p = SA[i];
+  return p == 0 ? 0 : T[p - 1];
+}
+
+template<class t_out>
+inline void eval(uint64_t c, int64_t m, std::vector<lcp_maxima>& R, t_out& out)
+{
+  if(m < R[c].len)
+  {
+    // process an active candidate
+    if(R[c].active)
+      out(R[c].pos);
+    // update to inactive state
+    R[c] = {m,0,false};
+  }
+}
+
+// modifies psv and nsv vectors with PSV(LCP) + 1 and NSV(LCP), respectively
+// (PSV is shifted by one so that "no smaller value" fits an unsigned entry)
+template<class t_lcp, class t_sv>
+void sv(const t_lcp& LCP, uint64_t N, t_sv& psv, t_sv& nsv,
+        std::vector<uint64_t>& stack_psv, std::vector<uint64_t>& stack_nsv)
+{
+  psv.resize(N);
+  nsv.resize(N);
+  stack_psv.clear();
+  stack_nsv.clear();
+  for(uint64_t i = 0; i < N; i++) {
+    nsv[i] = N + 1;
+    while(!stack_nsv.empty() and LCP[i] < LCP[stack_nsv.back()]) {
+      nsv[stack_nsv.back()] = i;
+      stack_nsv.pop_back();
+    }
+    stack_nsv.push_back(i);
+    while(!stack_psv.empty() and LCP[i] <= LCP[stack_psv.back()]) {
+      stack_psv.pop_back();
+    }
+    psv[i] = stack_psv.empty() ? 0 : stack_psv.back() + 1;
+    stack_psv.push_back(i);
+  }
+}
+
+/*
+ * linear_time: candidates are closed when the LCP drops below their length,
+ * using the LF pointers to bound the extension of the run head. Returns
+ * the number of equal-letter runs in the BWT.
+ */
+template<class t_text, class t_sa, class t_lcp, class t_out>
+uint64_t linear_time_scan(const t_text& T, t_sa& SA, const t_lcp& LCP, uint64_t N,
+                          uint64_t sigma, std::vector<lcp_maxima>& R,
+                          std::vector<int64_t>& pointers, t_out& out)
+{
+  int64_t m = std::numeric_limits<int64_t>::max();
+  uint64_t bwtruns = 1;
+
+  R.assign(sigma,{-1,0,false});
+
+  // compute pointers vector LF in the paper
+  pointers.assign(sigma,0);
+  for(uint64_t i = 1; i < N; i++) {
+    if(T[SA[i - 1]] != T[SA[i]]) {
+      pointers[T[SA[i]]] = i;
+    }
+    if(T[SA[i]] == sigma - 1) {
+      break;
+    }
+  }
+
+  uint64_t p = BWT(T,SA,0), c;
+  pointers[p]++;
+
+  for(uint64_t i=1;i<N;++i)
+  {
+    c = BWT(T,SA,i);
+    pointers[c]++;
+    m = std::min(m,int64_t(LCP[i]));
+
+    if(c != p)
+    {
+      eval(p,m,R,out);
+      if(int64_t(LCP[i]) > R[p].len and p != 0)
+        R[p] = {int64_t(LCP[i]),N - SA[i-1],true};
+
+      if(R[c].len != -1)
+        eval(c,int64_t(LCP[pointers[c] - 1]) - 1,R,out);
+      if(int64_t(LCP[i]) > R[c].len and c != 0)
+        R[c] = {int64_t(LCP[i]),N - SA[i],true};
+      // reset LCP value
+      m = std::numeric_limits<int64_t>::max();
+      // increment number of runs
+      bwtruns++;
+    }
+    p = c;
+  }
+
+  // evaluate last active candidates
+  for(uint64_t c = 1; c < sigma; ++c)
+    eval(c,-1,R,out);
+
+  return bwtruns;
+}
+
+/*
+ * one_pass: at every run boundary all candidates are evaluated against
+ * the minimum LCP value of the run; maxima_stack only visits those expiring.
+ */
+template<class t_text, class t_sa, class t_lcp, class t_out>
+uint64_t one_pass_scan(const t_text& T, t_sa& SA, const t_lcp& LCP, uint64_t N,
+                       uint64_t sigma, maxima_stack& R, t_out& out)
+{
+  int64_t m = std::numeric_limits<int64_t>::max();
+  uint64_t bwtruns = 1;
+
+  R.reset(sigma);
+
+  uint64_t p = BWT(T,SA,0), c;
+
+  for(uint64_t i=1;i<N;++i)
+  {
+    c = BWT(T,SA,i);
+    m = std::min(m,int64_t(LCP[i]));
+
+    if(c != p)
+    {
+      R.eval(m,out);
+
+      if(int64_t(LCP[i]) > R.len(p))
+        R.set(p,int64_t(LCP[i]),N - SA[i-1]);
+      if(int64_t(LCP[i]) > R.len(c))
+        R.set(c,int64_t(LCP[i]),N - SA[i]);
+      // reset LCP value
+      m = std::numeric_limits<int64_t>::max();
+      // increment number of runs
+      bwtruns++;
+    }
+    p = c;
+  }
+
+  // evaluate last active candidates
+  R.eval(-1,out);
+
+  return bwtruns;
+}
+
+/*
+ * lc: PSV and NSV of the LCP array are computed on the fly with two stacks.
+ */
+template<class t_text, class t_sa, class t_lcp, class t_out>
+uint64_t lc_scan(const t_text& T, t_sa& SA, const t_lcp& LCP, uint64_t N,
+                 uint64_t sigma, std::vector<lcp_candidate>& R,
+                 std::vector<uint64_t>& stack_psv, std::vector<uint64_t>& stack_nsv,
+                 t_out& out)
+{
+  uint64_t bwtruns = 1;
+
+  R.assign(sigma,{0, 0, true, int64_t(N + 1)});
+  stack_psv.assign(1,0);
+  stack_nsv.assign(1,0);
+
+  for(uint64_t i = 1; i < N; ++i) {
+    while (!stack_nsv.empty() and LCP[i] < LCP[stack_nsv.back()]) {
+      for (uint64_t j = stack_nsv.back() - 1; j <= stack_nsv.back(); j ++) {
+        R[BWT(T,SA,j)].nsv = i;
+      }
+      stack_nsv.pop_back();
+    }
+    if(BWT(T,SA,i) != BWT(T,SA,i - 1)) {
+      stack_nsv.push_back(i);
+      int64_t psv = 0;
+      while(!stack_psv.empty() and LCP[i] <= LCP[stack_psv.back()]) {
+        stack_psv.pop_back();
+      }
+      if (!stack_psv.empty()) {
+        psv = stack_psv.back();
+      }
+      for(uint64_t ip = i - 1; ip < (i + 1); ++ip) {
+        uint64_t c = BWT(T,SA,ip);
+        if (c != 0) {
+          bool candidate = false;
+          if (uint64_t(R[c].nsv) <= i and R[c].candidate) {
+            out(R[c].text_pos);
+          }
+          else {
+            candidate = R[c].candidate;
+          }
+          if(R[c].sa_pos <= psv) {
+            candidate = true;
+          }
+          R[c] = {int64_t(i), N - SA[ip], candidate, int64_t(N + 1)};
+        }
+      }
+      // increment number of runs
+      bwtruns++;
+    }
+    stack_psv.push_back(i);
+  }
+
+  // evaluate last active candidates
+  for(uint64_t c = 1; c < sigma; ++c) {
+    if(R[c].candidate)
+      out(R[c].text_pos);
+  }
+
+  return bwtruns;
+}
+
+/*
+ * plain_lc: same as lc, but PSV and NSV are precomputed arrays (PSV shifted by one).
+ */
+template<class t_text, class t_sa, class t_sv, class t_out>
+uint64_t plain_lc_scan(const t_text& T, t_sa& SA, const t_sv& PSV, const t_sv& NSV,
+                       uint64_t N, uint64_t sigma, std::vector<lcp_candidate>& R,
+                       t_out& out)
+{
+  uint64_t bwtruns = 1;
+
+  R.assign(sigma,{-2, 0, true, -1});
+
+  for(uint64_t i = 1; i < N; ++i) {
+    if(BWT(T,SA,i) != BWT(T,SA,i - 1)) {
+      for(uint64_t ip = i - 1; ip < (i + 1); ++ip) {
+        uint64_t c = BWT(T,SA,ip);
+        if (c != 0) {
+          bool candidate = false;
+          // nsv = -1 (no boundary seen yet) compares as unsigned infinity
+          if (uint64_t(R[c].nsv) <= i and R[c].candidate) {
+            out(R[c].text_pos);
+          }
+          else {
+            candidate = R[c].candidate;
+          }
+          if(R[c].sa_pos < int64_t(PSV[i])) {
+            candidate = true;
+          }
+          R[c] = {int64_t(i), N - SA[ip], candidate, int64_t(NSV[i])};
+        }
+      }
+      // increment number of runs
+      bwtruns++;
+    }
+  }
+
+  // evaluate last active candidates
+  for(uint64_t c = 1; c < sigma; ++c) {
+    if(R[c].candidate)
+      out(R[c].text_pos);
+  }
+
+  return bwtruns;
+}
+
+/*
+ * fm: a candidate is replaced only if it is not covered by the PSV of the
+ * current boundary, and emitted if its NSV precedes the boundary. PSV is
+ * shifted by one, as computed by sv().
+ */
+template<class t_text, class t_sa, class t_sv, class t_out>
+uint64_t fm_scan(const t_text& T, t_sa& SA, const t_sv& PSV, const t_sv& NSV,
+                 uint64_t N, uint64_t sigma, std::vector<lcp_candidate>& R,
+                 t_out& out)
+{
+  uint64_t bwtruns = 1;
+
+  R.assign(sigma,{-2, 0, false, std::numeric_limits<int64_t>::max()});
+
+  for(uint64_t i = 1; i < N; ++i) {
+    if(BWT(T,SA,i) != BWT(T,SA,i - 1)) {
+      for(uint64_t ip = i - 1; ip < (i + 1); ++ip) {
+        uint64_t c = BWT(T,SA,ip);
+        if (c != 0) {
+          if(R[c].sa_pos < int64_t(PSV[i])) {
+            if (R[c].nsv < int64_t(i)) {
+              out(R[c].text_pos);
+            }
+            R[c] = {int64_t(i), N - SA[ip], true, int64_t(NSV[i])};
+          }
+        }
+      }
+      // increment number of runs
+      bwtruns++;
+    }
+  }
+
+  // evaluate last active candidates
+  for(uint64_t c = 1; c < sigma; ++c) {
+    if(R[c].candidate)
+      out(R[c].text_pos);
+  }
+
+  return bwtruns;
+}
+
+} // namespace suffixient
+
+#endif /* end of include guard: _SUFFIXIENT_SCAN_HH */
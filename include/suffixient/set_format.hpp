@@ -0,0 +1,144 @@
+// Copyright (c) 2026, REGINDEX.  All rights reserved.
+// Use of this source code is governed
+// by a MIT license that can be found in the LICENSE file.
+/*
+    On-disk formats of a suffixient set.
+
+    raw:     one uint64_t storing |S| followed by |S| uint64_t.
+    compact: the 8-byte magic "SUFXSET1", then the header (text length
+             and alphabet size as uint64_t, the name of the algorithm as
+             one byte of length followed by its characters), |S| as
+             uint64_t and the sorted set as delta-varints: each gap from
+             the previous element (the first from 0) in 7-bit groups,
+             least significant first, the high bit set on all but the
+             last group.
+
+    load_set reads either format, telling them apart by the magic.
+*/
+
+#ifndef _SUFFIXIENT_SET_FORMAT_HH
+#define _SUFFIXIENT_SET_FORMAT_HH
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <algorithm>
+#include <stdexcept>
+
+namespace suffixient{
+
+constexpr char compact_magic[8] = {'S','U','F','X','S','E','T','1'};
+
+struct set_header{
+  uint64_t n = 0;         // text length
+  uint64_t sigma = 0;     // alphabet size
+  std::string algorithm;  // tool or engine that computed the set
+};
+
+// write the sorted set S in compact format to fd
+inline void write_compact(FILE* fd, const set_header& h, const std::vector<uint64_t>& S)
+{
+  std::vector<uint8_t> buf;
+  auto put = [&](uint64_t x){
+    buf.insert(buf.end(), (uint8_t*)&x, (uint8_t*)&x + sizeof(x));
+  };
+  buf.insert(buf.end(), compact_magic, compact_magic + sizeof(compact_magic));
+  put(h.n);
+  put(h.sigma);
+  uint8_t len = std::min<uint64_t>(h.algorithm.length(), 255);
+  buf.push_back(len);
+  buf.insert(buf.end(), h.algorithm.begin(), h.algorithm.begin() + len);
+  put(S.size());
+
+  // flushed every 1 MiB
+  uint64_t prev = 0;
+  for(auto x: S)
+  {
+    uint64_t gap = x - prev;
+    prev = x;
+    for(; gap >= 0x80; gap >>= 7)
+      buf.push_back(uint8_t(gap) | 0x80);
+    buf.push_back(uint8_t(gap));
+    if(buf.size() >= (1 << 20))
+    {
+      if(fwrite(buf.data(), 1, buf.size(), fd) != buf.size())
+        throw std::runtime_error("S write error");
+      buf.clear();
+    }
+  }
+  if(fwrite(buf.data(), 1, buf.size(), fd) != buf.size())
+    throw std::runtime_error("S write error");
+}
+
+// load the set stored in path, in raw or compact format; the header is
+// filled in only for the compact format
+inline void load_set(const std::string& path, std::vector<uint64_t>& S, set_header* h = nullptr)
+{
+  FILE* fd = fopen(path.c_str(), "rb");
+  if(fd == nullptr)
+    throw std::runtime_error("open() file " + path + " failed");
+  auto get = [&](void* p, uint64_t bytes){
+    if(fread(p, 1, bytes, fd) != bytes)
+    {
+      fclose(fd);
+      throw std::runtime_error("file " + path + " is truncated");
+    }
+  };
+
+  uint64_t size;
+  char magic[sizeof(compact_magic)];
+  get(magic, sizeof(magic));
+  if(memcmp(magic, compact_magic, sizeof(magic)) != 0)
+  {
+    memcpy(&size, magic, sizeof(size));
+    S.resize(size);
+    get(S.data(), size * sizeof(uint64_t));
+    fclose(fd);
+    return;
+  }
+
+  set_header header;
+  get(&header.n, sizeof(header.n));
+  get(&header.sigma, sizeof(header.sigma));
+  uint8_t len;
+  get(&len, 1);
+  header.algorithm.resize(len);
+  get(&header.algorithm[0], len);
+  get(&size, sizeof(size));
+  if(h != nullptr)
+    *h = header;
+
+  S.resize(size);
+  std::vector<uint8_t> buf(1 << 20);
+  uint64_t filled = 0, pos = 0, prev = 0;
+  for(uint64_t i = 0; i < size; ++i)
+  {
+    uint64_t gap = 0;
+    for(uint8_t shift = 0; ; shift += 7)
+    {
+      if(pos == filled)
+      {
+        filled = fread(buf.data(), 1, buf.size(), fd);
+        pos = 0;
+        if(filled == 0)
+        {
+          fclose(fd);
+          throw std::runtime_error("file " + path + " is truncated");
+        }
+      }
+      uint8_t b = buf[pos++];
+      gap |= uint64_t(b & 0x7f) << shift;
+      if((b & 0x80) == 0)
+        break;
+    }
+    prev += gap;
+    S[i] = prev;
+  }
+  fclose(fd);
+}
+
+} // namespace suffixient
+
+#endif /* end of include guard: _SUFFIXIENT_SET_FORMAT_HH */
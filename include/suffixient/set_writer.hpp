@@ -0,0 +1,183 @@
+// Copyright (c) 2026, REGINDEX.  All rights reserved.
+// Use of this source code is governed
+// by a MIT license that can be found in the LICENSE file.
+/*
+    Output sink for the suffixient set. Elements are written as soon as
+    they are pushed, so that without sorting no element is kept in memory.
+    The binary format is one uint64_t storing |S| followed by |S| uint64_t;
+    the size is patched in when the writer is closed. For a collection,
+    each element is written as its (document, offset) pair, two uint64_t
+    in binary format and document:offset in human-readable format.
+    Optionally, the file is written in the compact format of
+    set_format.hpp. Sorting (-s, or the compact format) is a parallel
+    radix sort.
+*/
+
+#ifndef _SUFFIXIENT_SET_WRITER_HH
+#define _SUFFIXIENT_SET_WRITER_HH
+
+#include <cstdio>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <stdexcept>
+
+#include <collection.hpp>
+#include <radix_sort.hpp>
+#include <set_format.hpp>
+
+namespace suffixient{
+
+class set_writer{
+public:
+
+  // an empty output_file streams the set to standard output in human-readable format;
+  // with docs, the elements are positions of the collection. compact selects the
+  // compact format for output_file, which implies sorting; threads sort the set.
+  set_writer(const std::string& output_file, bool sort_ = false, const documents* docs_ = nullptr,
+             bool compact_ = false, uint32_t threads_ = 1)
+    : sort(sort_), docs(docs_), threads(threads_)
+  {
+    if(output_file.length() != 0)
+    {
+      compact = compact_;
+      if(compact and docs != nullptr)
+        throw std::invalid_argument("the compact format does not store collections");
+      if((fd = fopen(output_file.c_str(), "wb")) == nullptr)
+        throw std::runtime_error("open() file " + output_file + " failed");
+      // placeholder for |S|
+      if(not compact)
+        write(0);
+    }
+    sort = sort or compact;
+  }
+
+  // a destructor must not throw: call close() to see the write errors
+  ~set_writer()
+  {
+    try{
+      if(not closed)
+        close();
+    }catch(const std::exception& e){
+      std::cerr << "Error: " << e.what() << std::endl;
+    }
+    if(fd != nullptr)
+      fclose(fd);
+  }
+
+  set_writer(const set_writer&) = delete;
+  set_writer& operator=(const set_writer&) = delete;
+
+  void push(uint64_t x)
+  {
+    size_++;
+    if(sort)
+      buffer.push_back(x);
+    else
+      write_element(x);
+  }
+
+  // text length, alphabet size and algorithm stored in the header of the compact format
+  void describe(uint64_t n, uint64_t sigma, const std::string& algorithm)
+  {
+    header.n = n;
+    header.sigma = sigma;
+    header.algorithm = algorithm;
+  }
+
+  // sort the buffered elements (sorted mode); otherwise close() does it. Separate,
+  // so that the sort can be timed on its own
+  void sort_elements()
+  {
+    if(sort and not sorted)
+      radix_sort(buffer, threads);
+    sorted = true;
+  }
+
+  // write the buffered elements (sorted mode) and the final size
+  void close()
+  {
+    closed = true;
+    sort_elements();
+
+    if(compact)
+    {
+      write_compact(fd, header, buffer);
+      std::vector<uint64_t>().swap(buffer);
+      finish();
+      return;
+    }
+
+    if(sort)
+    {
+      for(auto x: buffer)
+        write_element(x);
+      std::vector<uint64_t>().swap(buffer);
+    }
+
+    if(fd == nullptr)
+      std::cout << std::endl;
+    else
+    {
+      if(fseek(fd, 0, SEEK_SET) != 0)
+        throw std::runtime_error("S size write error");
+      write(size_);
+      finish();
+    }
+  }
+
+  // number of elements pushed so far
+  uint64_t size() const { return size_; }
+
+private:
+
+  bool sort;
+  bool sorted = false;
+  bool closed = false;
+  const documents* docs;
+  bool compact = false;
+  uint32_t threads;
+  set_header header;
+  FILE *fd = nullptr;
+  uint64_t size_ = 0;
+  std::vector<uint64_t> buffer;
+
+  // fclose() flushes the buffered writes, which may fail
+  void finish()
+  {
+    FILE *f = fd;
+    fd = nullptr;
+    if(fclose(f) != 0)
+      throw std::runtime_error("S write error");
+  }
+
+  inline void write_element(uint64_t x)
+  {
+    if(docs == nullptr)
+    {
+      write(x);
+      return;
+    }
+    auto d = docs->locate(x);
+    if(fd == nullptr)
+      std::cout << d.first << ":" << d.second << " ";
+    else
+    {
+      write(d.first);
+      write(d.second);
+    }
+  }
+
+  inline void write(uint64_t x)
+  {
+    if(fd == nullptr)
+      std::cout << x << " ";
+    else if(fwrite(&x, sizeof(x), 1, fd) != 1)
+      throw std::runtime_error("S write error");
+  }
+};
+
+} // namespace suffixient
+
+#endif /* end of include guard: _SUFFIXIENT_SET_WRITER_HH */
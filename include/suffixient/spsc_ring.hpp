@@ -0,0 +1,65 @@
+// Copyright (c) 2026, REGINDEX.  All rights reserved.
+// Use of this source code is governed
+// by a MIT license that can be found in the LICENSE file.
+/*
+    Bounded ring of slots handed from one producer thread to one consumer
+    thread. Slots are filled and read in place, so their buffers are
+    allocated once and reused.
+*/
+
+#ifndef _SUFFIXIENT_SPSC_RING_HH
+#define _SUFFIXIENT_SPSC_RING_HH
+
+#include <vector>
+#include <atomic>
+#include <thread>
+#include <cstdint>
+
+namespace suffixient{
+
+template<class T>
+class spsc_ring{
+public:
+
+  explicit spsc_ring(uint64_t capacity) : slots(capacity) {}
+
+  // producer: next slot to fill, waiting while the ring is full
+  T& write_slot()
+  {
+    uint64_t h = head.load(std::memory_order_relaxed);
+    while(h - tail.load(std::memory_order_acquire) == slots.size())
+      std::this_thread::yield();
+    return slots[h % slots.size()];
+  }
+
+  // producer: hand the filled slot to the consumer
+  void push()
+  {
+    head.store(head.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+  }
+
+  // consumer: next filled slot, waiting while the ring is empty
+  T& read_slot()
+  {
+    uint64_t t = tail.load(std::memory_order_relaxed);
+    while(head.load(std::memory_order_acquire) == t)
+      std::this_thread::yield();
+    return slots[t % slots.size()];
+  }
+
+  // consumer: give the read slot back to the producer
+  void pop()
+  {
+    tail.store(tail.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+  }
+
+private:
+
+  std::vector<T> slots;
+  alignas(64) std::atomic<uint64_t> head{0};  // slots pushed
+  alignas(64) std::atomic<uint64_t> tail{0};  // slots popped
+};
+
+} // namespace suffixient
+
+#endif /* end of include guard: _SUFFIXIENT_SPSC_RING_HH */
@@ -0,0 +1,160 @@
+// Copyright (c) 2026, REGINDEX.  All rights reserved.
+// Use of this source code is governed
+// by a MIT license that can be found in the LICENSE file.
+/*
+    Report of a run: wall time, CPU time (all threads) and memory of each
+    phase, plus named counters, written as JSON. The peak heap of a phase
+    is taken from malloc_count when the executable links it (and defines
+    SUFFIXIENT_MALLOC_COUNT); the peak resident set size is the high-water
+    mark of the process at the end of the phase.
+*/
+
+#ifndef _SUFFIXIENT_STATS_HH
+#define _SUFFIXIENT_STATS_HH
+
+#include <string>
+#include <vector>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <cstdint>
+#include <algorithm>
+
+#include <time.h>
+#include <sys/resource.h>
+
+#ifdef SUFFIXIENT_MALLOC_COUNT
+#include <malloc_count.h>
+#endif
+
+namespace suffixient{
+
+class run_stats{
+public:
+
+  explicit run_stats(const std::string& tool_ = "") : tool(tool_)
+  {
+    start_wall = wall_time();
+    start_cpu = cpu_time();
+  }
+
+  // end the current phase and start phase name (nothing if it is the current one)
+  void begin(const std::string& name)
+  {
+    if(running and phases.back().name == name)
+      return;
+    end();
+    phases.push_back({name, wall_time(), cpu_time(), 0, 0, 0});
+    running = true;
+#ifdef SUFFIXIENT_MALLOC_COUNT
+    malloc_count_reset_peak();
+#endif
+  }
+
+  // end the current phase, if any
+  void end()
+  {
+    if(not running)
+      return;
+    phase& p = phases.back();
+    p.wall = wall_time() - p.wall;
+    p.cpu = cpu_time() - p.cpu;
+#ifdef SUFFIXIENT_MALLOC_COUNT
+    p.peak_heap = malloc_count_peak();
+    p.heap = malloc_count_current();
+#endif
+    p.peak_rss_kb = peak_rss_kb();
+    running = false;
+  }
+
+  // set counter name to x
+  void count(const std::string& name, uint64_t x)
+  {
+    for(auto& c: counters)
+      if(c.first == name)
+      {
+        c.second = x;
+        return;
+      }
+    counters.push_back({name, x});
+  }
+
+  // write the report to path, ending the current phase
+  void write_json(const std::string& path)
+  {
+    std::ofstream out(path);
+    if(not out)
+      throw std::runtime_error("open() file " + path + " failed");
+    write_json(out);
+  }
+
+  void write_json(std::ostream& out)
+  {
+    end();
+    uint64_t peak_heap = 0;
+    out << "{\"tool\":\"" << tool << "\",\"phases\":[";
+    for(uint64_t k = 0; k < phases.size(); ++k)
+    {
+      const phase& p = phases[k];
+      peak_heap = std::max(peak_heap, p.peak_heap);
+      out << (k ? "," : "") << "{\"name\":\"" << p.name << "\",\"wall_s\":" << p.wall
+          << ",\"cpu_s\":" << p.cpu << ",\"peak_heap_bytes\":" << heap_value(p.peak_heap)
+          << ",\"heap_bytes_end\":" << heap_value(p.heap) << ",\"peak_rss_kb\":" << p.peak_rss_kb << "}";
+    }
+    out << "],\"counters\":{";
+    for(uint64_t k = 0; k < counters.size(); ++k)
+      out << (k ? "," : "") << "\"" << counters[k].first << "\":" << counters[k].second;
+    out << "},\"total\":{\"wall_s\":" << wall_time() - start_wall << ",\"cpu_s\":" << cpu_time() - start_cpu
+        << ",\"peak_heap_bytes\":" << heap_value(peak_heap) << ",\"peak_rss_kb\":" << peak_rss_kb() << "}}" << std::endl;
+  }
+
+private:
+
+  struct phase{
+    std::string name;
+    double wall, cpu;  // start times while running
+    uint64_t peak_heap, heap;
+    uint64_t peak_rss_kb;
+  };
+
+  std::string tool;
+  std::vector<phase> phases;
+  std::vector<std::pair<std::string, uint64_t>> counters;
+  bool running = false;
+  double start_wall, start_cpu;
+
+  static double wall_time()
+  {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+  }
+
+  static double cpu_time()
+  {
+    struct timespec t;
+    clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &t);
+    return t.tv_sec + t.tv_nsec / 1e9;
+  }
+
+  static uint64_t peak_rss_kb()
+  {
+    struct rusage ru;
+    getrusage(RUSAGE_SELF, &ru);
+    return ru.ru_maxrss;
+  }
+
+  // heap sizes are null without malloc_count
+  static std::string heap_value(uint64_t x)
+  {
+#ifdef SUFFIXIENT_MALLOC_COUNT
+    return std::to_string(x);
+#else
+    (void)x;
+    return "null";
+#endif
+  }
+};
+
+} // namespace suffixient
+
+#endif /* end of include guard: _SUFFIXIENT_STATS_HH */
@@ -0,0 +1,174 @@
+// Copyright (c) 2026, REGINDEX.  All rights reserved.
+// Use of this source code is governed
+// by a MIT license that can be found in the LICENSE file.
+/*
+    In-process engine computing a smallest suffixient set of a text.
+    The engine owns the reversed text, SA and LCP buffers, so that
+    successive calls on the same engine reuse them.
+*/
+
+#ifndef _SUFFIXIENT_HH
+#define _SUFFIXIENT_HH
+
+#include <vector>
+#include <string>
+#include <memory>
+#include <functional>
+#include <cstdint>
+
+#include <sdsl/construct.hpp>
+
+#include <scan.hpp>
+#include <parallel_scan.hpp>
+#include <build.hpp>
+#include <stats.hpp>
+#include <array_cache.hpp>
+
+namespace suffixient{
+
+enum class algorithm{
+  linear_time, // suffixient
+  one_pass,    // one-pass
+  lc,          // lc
+  plain_lc,    // plain_lc
+  fm           // fm
+};
+
+enum class lcp_algorithm{
+  kasai, // text + SA + ISA + LCP
+  phi    // text + SA + LCP + 2N bits
+};
+
+struct options{
+  algorithm algo = algorithm::linear_time;
+  lcp_algorithm lcp = lcp_algorithm::kasai;
+  bool remap = false;      // map characters to integers in the range 1,2,...,sigma
+  bool in_memory = false;  // build SA and LCP in RAM, without sdsl cache files
+  uint32_t threads = 1;    // threads for SA and LCP construction (libsais and Phi
+                           // when > 1) and, with in_memory, for the linear_time scan
+  uint8_t symbol_bytes = 1;  // > 1: the text is a sequence of little-endian integers
+                             // of this many bytes (up to 4), an integer alphabet
+                             // mapped to 1,2,...,sigma in increasing order; SA and
+                             // LCP are then always built in RAM
+  bool collection = false;  // the text is a collection of documents separated by
+                            // separator: substrings do not cross separators, which
+                            // end their document like the end of the text. Implies
+                            // in_memory
+  uint8_t separator = '\n';
+  run_stats* stats = nullptr;  // if not null, timed phases (ingestion, sa, lcp, psv_nsv,
+                               // scan) and counters of the engine are recorded there
+  std::string cache_dir;  // if not empty, persistent cache directory: SA and LCP are
+                          // stored there, keyed by a hash of the reversed text, and
+                          // later runs on the same text map them instead of building
+};
+
+class engine{
+public:
+
+  engine(algorithm algo_ = algorithm::linear_time, bool remap_ = false);
+  engine(const options& opt_);
+  ~engine();
+
+  engine(const engine&) = delete;
+  engine& operator=(const engine&) = delete;
+
+  // compute a smallest suffixient set of text[0..n-1] and store it in S
+  // (n counts bytes: with an integer alphabet, text holds n / symbol_bytes symbols)
+  void run(const char* text, uint64_t n, std::vector<uint64_t>& S);
+
+  // compute a smallest suffixient set of text[0..n-1], calling out once per element
+  void run(const char* text, uint64_t n, const std::function<void(uint64_t)>& out);
+
+  // store the reversed text, followed by the 0x0 terminator, in T (in T_int
+  // with an integer alphabet). In a collection, the separators are stored as 0x0
+  void set_text(const char* text, uint64_t n);
+
+  // build SA and LCP of the reversed text
+  void construct();
+
+  // stream the suffixient set of the current text to out
+  void scan(const std::function<void(uint64_t)>& out);
+
+  // length of the last text, including the 0x0 terminator
+  uint64_t length() const { return N; }
+
+  // alphabet size of the last text, including the terminator
+  uint64_t alphabet_size() const { return sigma; }
+
+  // number of equal-letter runs in the BWT of the last reversed text
+  uint64_t bwt_runs() const { return bwtruns; }
+
+  // bits per entry of the SA, LCP, PSV and NSV arrays of the last text
+  uint8_t width() const { return w; }
+
+private:
+
+  options opt;
+
+  sdsl::cache_config cc;
+
+  uint64_t N = 0;      // including 0x0 terminator
+  uint64_t sigma = 1;  // alphabet size (including terminator 0x0)
+  uint64_t bwtruns = 0;
+
+  uint8_t w = 32;
+
+  // arrays indexed by SA position, with entries of t_width bits
+  template<uint8_t t_width>
+  struct index_arrays{
+    sdsl::int_vector<t_width> SA;   // SA built in RAM (empty with sdsl cache)
+    sdsl::int_vector<t_width> LCP;
+    sdsl::int_vector<t_width> PSV;  // PSV(LCP) + 1
+    sdsl::int_vector<t_width> NSV;
+    // SA and LCP mapped from the persistent cache (null if built)
+    std::unique_ptr<sdsl::read_only_mapper<t_width>> SA_map, LCP_map;
+  };
+
+  sdsl::int_vector<8> T;
+  sdsl::int_vector<32> T_int;    // integer alphabet
+  sdsl::int_vector_buffer<> SA;  // SA from the sdsl cache
+  index_arrays<32> A32;          // N + 1 < 2^32
+  index_arrays<40> A40;          // otherwise
+
+  // scan state, kept across calls
+  std::vector<lcp_maxima> R_max;
+  maxima_stack R_stack;
+  std::vector<lcp_candidate> R_cand;
+  std::vector<int64_t> pointers;
+  std::vector<uint64_t> stack_psv, stack_nsv;
+
+  // store the n little-endian integers of text, reversed and mapped to 1,2,...,sigma-1
+  void set_integer_text(const char* text, uint64_t n);
+
+  // map SA and LCP from the persistent cache, or build them (and store them there)
+  template<uint8_t t_width>
+  void construct(index_arrays<t_width>& A);
+
+  template<uint8_t t_width>
+  void build(index_arrays<t_width>& A);
+
+  template<class t_text, uint8_t t_width>
+  void build_lcp(const t_text& text, index_arrays<t_width>& A);
+
+  template<uint8_t t_width>
+  void scan(index_arrays<t_width>& A, const std::function<void(uint64_t)>& out);
+
+  template<class t_text, class t_sa, class t_lcp, uint8_t t_width>
+  void scan(const t_text& text, t_sa& SA, const t_lcp& LCP, index_arrays<t_width>& A,
+            const std::function<void(uint64_t)>& out);
+
+  // remove sdsl cache files of the last construction and unmap the arrays
+  // of the persistent cache
+  void clear_cache();
+
+  // start phase name of opt.stats, if any
+  void phase(const char* name)
+  {
+    if(opt.stats != nullptr)
+      opt.stats->begin(name);
+  }
+};
+
+} // namespace suffixient
+
+#endif /* end of include guard: _SUFFIXIENT_HH */
@@ -0,0 +1,204 @@
+// Copyright (c) 2026, REGINDEX.  All rights reserved.
+// Use of this source code is governed
+// by a MIT license that can be found in the LICENSE file.
+/*
+    Command-line driver shared by the tools running one algorithm of the
+    engine (suffixient, one-pass, lc, plain_lc, fm): option parsing, help
+    text, input, engine, set writer and report. It is header-only, so that
+    the run report of each tool follows the malloc_count setting of its
+    executable.
+*/
+
+#ifndef _SUFFIXIENT_TOOL_HH
+#define _SUFFIXIENT_TOOL_HH
+
+#include <iostream>
+#include <string>
+#include <cstdlib>
+#include <algorithm>
+#include <getopt.h>
+
+#include <suffixient.hpp>
+#include <set_writer.hpp>
+#include <input_text.hpp>
+#include <stats.hpp>
+
+namespace suffixient{
+
+// lc and plain_lc map the characters to 1,2,...,sigma by default: -t turns it off
+inline bool remaps_by_default(algorithm algo)
+{
+  return algo == algorithm::lc or algo == algorithm::plain_lc;
+}
+
+inline void tool_help(const std::string& name, algorithm algo)
+{
+  bool necessary = remaps_by_default(algo);
+
+  std::cout << name << " [options]" << std::endl <<
+  "Input: non-empty ASCII file without character 0x0, from standard input or from file (option -i). Output: smallest " <<
+  (necessary ? "suffixient-nexessary" : "suffixient") << " set." << std::endl <<
+  "Warning: if 0x0 appears, the input is read only until the first occurrence of 0x0 (excluded)." << std::endl <<
+  "Options:" << std::endl <<
+  "-h          Print usage info." << std::endl <<
+  "-i <arg>    Read the input text from file, mapping it in memory. If not specified, the text is read from standard input." << std::endl <<
+  "-o <arg>    Store output to file using 64-bits unsigned integers. If not specified, output is streamed to standard output in human-readable format." << std::endl <<
+  "-s          Sort output. Default: false." << std::endl <<
+  "-z          Store the output file (-o) in the compact format: sorted, delta-varint encoded, with a header holding text length, alphabet size and algorithm. Readable by test. Not with -c. Default: false." << std::endl <<
+  "-p          Print to standard output size of suffixient set. Default: false." << std::endl <<
+  "-r          Print to standard output number of equal-letter runs in the BWT of reverse text. Default: false." << std::endl <<
+  (necessary ? "-t          Use alphabet of size sigma (debug only). Default: false."
+             : "-t          Map characters to integers in the range 1,2,...,sigma. Default: false.") << std::endl <<
+  "-m          Build SA and LCP in main memory, without sdsl cache files. Default: false." << std::endl <<
+  "-l          Build the LCP array with the Phi algorithm, using less memory than Kasai's algorithm. Default: false." << std::endl <<
+  "-c          Collection mode: the input is a collection of documents, one per line. Substrings do not cross the newlines, and each element of the output is a pair document:offset, with documents numbered from 0 and offsets 1-based end positions in the document (two uint64_t with -o). Implies -m. Default: false." << std::endl <<
+  "-b <arg>    Integer alphabet: read the input whole as little-endian unsigned integers of <arg> bytes (2, 3 or 4), mapped to 1,2,...,sigma in increasing order. Implies -m. Default: 1 (characters)." << std::endl <<
+  "-C <arg>    Persistent cache directory, created if missing: SA and LCP are stored there, keyed by a hash of the reversed text, and later runs on the same text map them in memory instead of building them. Default: none." << std::endl <<
+  "-T <arg>    Number of threads for suffix and LCP array construction (parallel libsais and Phi if greater than 1)" <<
+  (algo == algorithm::linear_time ? " and, with -m, for the scan" : "") << ". Default: 1." << std::endl <<
+  "--stats-json <arg>  Write wall time, CPU time and peak memory of each phase (ingestion, sa, lcp, psv_nsv, scan, sort with -s or -z, output) and counters to file <arg>, as JSON." << std::endl;
+  exit(0);
+}
+
+// main of the tool name running algo
+inline int run_tool(int argc, char** argv, const std::string& name, algorithm algo)
+{
+  std::string output_file, input_file, stats_file, cache_dir;
+
+  bool sort = false;
+  bool rho = false;
+  bool runs = false;
+  bool flip_remap = false;
+  bool in_memory = false;
+  bool lean_lcp = false;
+  bool collection = false;
+  bool compact = false;
+  int threads = 1;
+  int symbol_bytes = 1;
+
+  const struct option long_options[] = {
+    {"stats-json", required_argument, nullptr, 'J'},
+    {nullptr, 0, nullptr, 0}
+  };
+
+  int opt;
+  while ((opt = getopt_long(argc, argv, "prshtmlzco:i:T:b:C:", long_options, nullptr)) != -1){
+    switch (opt){
+      case 'h':
+        tool_help(name, algo);
+      break;
+      case 'o':
+        output_file = std::string(optarg);
+      break;
+      case 'i':
+        input_file = std::string(optarg);
+      break;
+      case 's':
+        sort=true;
+      break;
+      case 'p':
+        rho=true;
+      break;
+      case 'r':
+        runs=true;
+      break;
+      case 't':
+        flip_remap=true;
+      break;
+      case 'm':
+        in_memory=true;
+      break;
+      case 'l':
+        lean_lcp=true;
+      break;
+      case 'c':
+        collection=true;
+      break;
+      case 'z':
+        compact=true;
+      break;
+      case 'T':
+        threads = atoi(optarg);
+      break;
+      case 'b':
+        symbol_bytes = atoi(optarg);
+      break;
+      case 'C':
+        cache_dir = std::string(optarg);
+      break;
+      case 'J':
+        stats_file = std::string(optarg);
+      break;
+      default:
+        tool_help(name, algo);
+      return -1;
+    }
+  }
+
+  if(symbol_bytes < 1 or symbol_bytes > 4){
+    std::cerr << "Error: symbols must have from 1 to 4 bytes" << std::endl;
+    tool_help(name, algo);
+  }
+  if(compact and output_file.length() == 0){
+    std::cerr << "Error: the compact format needs an output file (-o)" << std::endl;
+    tool_help(name, algo);
+  }
+  if(compact and collection){
+    std::cerr << "Error: the compact format does not store collections" << std::endl;
+    tool_help(name, algo);
+  }
+
+  run_stats stats(name);
+  stats.begin("ingestion");
+  input_text in(input_file, symbol_bytes > 1);
+
+  if(in.size() == 0){
+    std::cerr << "Error: empty text" << std::endl;
+    tool_help(name, algo);
+  }
+  if(in.size() % symbol_bytes != 0){
+    std::cerr << "Error: text length is not a multiple of " << symbol_bytes << " bytes" << std::endl;
+    tool_help(name, algo);
+  }
+
+  options cfg;
+  cfg.algo = algo;
+  cfg.remap = remaps_by_default(algo) != flip_remap;
+  cfg.in_memory = in_memory;
+  cfg.lcp = lean_lcp ? lcp_algorithm::phi : lcp_algorithm::kasai;
+  cfg.threads = std::max(threads,1);
+  cfg.symbol_bytes = symbol_bytes;
+  cfg.collection = collection;
+  cfg.stats = &stats;
+  cfg.cache_dir = cache_dir;
+
+  engine E(cfg);
+  // documents of a collection, to report (document, offset) pairs
+  documents docs(in.data(), collection ? in.size() : 0, '\n', cfg.threads);
+  set_writer S(output_file,sort,collection ? &docs : nullptr,compact,cfg.threads);
+  E.run(in.data(),in.size(),[&S](uint64_t x){ S.push(x); });
+  if(sort or compact)
+  {
+    stats.begin("sort");
+    S.sort_elements();
+  }
+  stats.begin("output");
+  S.describe(in.size() / symbol_bytes,E.alphabet_size(),name);
+  S.close();
+  uint64_t bwtruns = E.bwt_runs();
+
+  if(stats_file.length() != 0){
+    stats.count("suffixient_size", S.size());
+    if(collection)
+      stats.count("documents", docs.size());
+    stats.write_json(stats_file);
+  }
+
+  if(rho) std::cout << "Size of smallest suffixient set: " << S.size() << std::endl;
+  if(runs) std::cout << "Number of equal-letter BWT(rev(T)) runs: " << bwtruns << std::endl;
+  return 0;
+}
+
+} // namespace suffixient
+
+#endif /* end of include guard: _SUFFIXIENT_TOOL_HH */
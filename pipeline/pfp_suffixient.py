@@ -34,7 +34,7 @@ def main():
   #parser.add_argument('-v',  help='verbose',action='store_true')
   parser.add_argument('-c',  help='print size of the suffixient set to console',action='store_true')
   parser.add_argument('-r',  help='print the number of runs of the BWT',action='store_true')
-  parser.add_argument('-i',  help='invert the text before running PFP',action='store_true')
+  parser.add_argument('-i',  help='invert the text before running PFP (parsed backwards by pfp_suffixient -f, with no copy)',action='store_true')
   #parser.add_argument('-m', help='print memory usage',action='store_true')
   args = parser.parse_args()
 
@@ -43,13 +43,14 @@ def main():
   args.bigbwt_dir = os.path.split(sys.argv[0])[0]
   print("Sending logging messages to file:", logfile_name)
   if args.i:
-    text = ""
-    with open(args.input,"r") as file:
-      text = file.read()
-    text = reversed(text)
-    args.input += ".inv"
-    with open(args.input,"a") as file:
-      file.write("".join(text))
+    # the native driver parses the reversed text directly
+    command = "{exe} -f {file} -w {wsize} -m {modulus}".format(
+            exe = os.path.join(args.bigbwt_dir,suffixient_exe),
+            file = args.input, wsize = args.wsize, modulus = args.mod)
+    command += suffixient_flags(args)
+    print("==== Compute suffixient. Command:", command)
+    subprocess.run(command.split())
+    return
   with open(logfile_name,"a") as logfile:
     args.logfile = logfile
     args.logfile_name = logfile_name
@@ -88,17 +89,25 @@ def main():
   command = "{exe} -i {file} -w {wsize} -n {size}".format(
           exe = os.path.join(args.bigbwt_dir,suffixient_exe),
           file = args.input, wsize = args.wsize, size =  os.path.getsize(args.input)+1)
-  if args.o != "":
-    command += " -o {out_file}".format(out_file=args.o)
-  if args.c:
-    command += " -p"
-  if args.r:
-    command += " -r"
+  command += suffixient_flags(args)
   print("==== Compute suffixient. Command:", command)
   #if(execute_command(command,logfile,logfile_name)!=True):
   #  return
   subprocess.run(command.split())
 
+# output options of pfp_suffixient
+def suffixient_flags(args):
+  flags = ""
+  if args.t > 0:
+    flags += " -t {th}".format(th=args.t)
+  if args.o != "":
+    flags += " -o {out_file}".format(out_file=args.o)
+  if args.c:
+    flags += " -p"
+  if args.r:
+    flags += " -r"
+  return flags
+
 # delete intermediate files
 def delete_temp_files(args,logfile,logfile_name):
     #if args.k==False:
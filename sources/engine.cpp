@@ -0,0 +1,314 @@
+// Copyright (c) 2026, REGINDEX.  All rights reserved.
+// Use of this source code is governed
+// by a MIT license that can be found in the LICENSE file.
+
+#include <stdexcept>
+#include <algorithm>
+#include <type_traits>
+
+#include <suffixient.hpp>
+
+using namespace sdsl;
+
+namespace suffixient{
+
+engine::engine(algorithm algo_, bool remap_)
+{
+  opt.algo = algo_;
+  opt.remap = remap_;
+}
+
+engine::engine(const options& opt_) : opt(opt_)
+{
+  // the LCP array of a collection stops at the separators, which only the
+  // in-memory builders do
+  if(opt.collection)
+    opt.in_memory = true;
+}
+
+engine::~engine()
+{
+  clear_cache();
+}
+
+void engine::run(const char* text, uint64_t n, std::vector<uint64_t>& S)
+{
+  S.clear();
+  run(text, n, [&S](uint64_t x){ S.push_back(x); });
+}
+
+void engine::run(const char* text, uint64_t n, const std::function<void(uint64_t)>& out)
+{
+  set_text(text, n);
+  construct();
+  scan(out);
+  clear_cache();
+}
+
+void engine::set_text(const char* text, uint64_t n)
+{
+  phase("ingestion");
+  if(opt.symbol_bytes > 1)
+  {
+    if(opt.collection)
+      throw std::invalid_argument("collections of integer texts are not supported");
+    if(opt.symbol_bytes > 4 or n % opt.symbol_bytes != 0)
+      throw std::invalid_argument("text is not a sequence of symbols of " +
+                                  std::to_string(opt.symbol_bytes) + " bytes");
+    set_integer_text(text, n / opt.symbol_bytes);
+    return;
+  }
+
+  if(n == 0)
+    throw std::invalid_argument("empty text");
+
+  N = n + 1;
+  sigma = 1;
+  T.resize(N);
+  T_int = int_vector<32>();
+
+  if(not opt.remap)
+  {
+    // the characters are independent: the documents of a collection are
+    // reversed in parallel
+    uint8_t sep = opt.collection ? opt.separator : 0;
+    parallel_blocks(N - 1, opt.collection ? opt.threads : 1, 8, [&](uint64_t b, uint64_t e){
+      for(uint64_t i = b; i < e; ++i)
+      {
+        uint8_t c = text[N - i - 2];
+        T[i] = c == sep ? 0 : c;
+      }
+    });
+    sigma = 128;
+  }
+  else
+  {
+    uint8_t char_to_int[256] = {0}; //map chars to 0...sigma-1. 0 is reserved for term.
+    int sep = opt.collection ? opt.separator : -1;
+    for(uint64_t i = 0; i < N - 1; ++i)
+    {
+      uint8_t c = text[N - i - 2];
+      if(c == sep) { T[i] = 0; continue; }
+      if(char_to_int[c] == 0) char_to_int[c] = sigma++;
+      T[i] = char_to_int[c];
+    }
+  }
+  T[N - 1] = 0;
+}
+
+void engine::set_integer_text(const char* text, uint64_t n)
+{
+  if(n == 0)
+    throw std::invalid_argument("empty text");
+
+  N = n + 1;
+  T = int_vector<8>();
+
+  auto symbol = [&](uint64_t i){
+    uint32_t x = 0;
+    for(uint8_t b = 0; b < opt.symbol_bytes; ++b)
+      x |= uint32_t(uint8_t(text[i * opt.symbol_bytes + b])) << (8 * b);
+    return x;
+  };
+
+  // sorted alphabet: symbol alphabet[k] is mapped to k + 1. 0 is reserved for term.
+  std::vector<uint32_t> alphabet(n);
+  for(uint64_t i = 0; i < n; ++i)
+    alphabet[i] = symbol(i);
+  std::sort(alphabet.begin(), alphabet.end());
+  alphabet.erase(std::unique(alphabet.begin(), alphabet.end()), alphabet.end());
+  if(alphabet.size() >= std::numeric_limits<uint32_t>::max())
+    throw std::length_error("alphabet larger than 2^32 - 2 symbols");
+  sigma = alphabet.size() + 1;
+
+  T_int.resize(N);
+  for(uint64_t i = 0; i < N - 1; ++i)
+    T_int[i] = std::lower_bound(alphabet.begin(), alphabet.end(), symbol(N - i - 2)) - alphabet.begin() + 1;
+  T_int[N - 1] = 0;
+}
+
+void engine::construct()
+{
+  w = index_width(N);
+  if(opt.stats != nullptr)
+  {
+    opt.stats->count("text_length", N - 1);
+    opt.stats->count("alphabet_size", sigma);
+  }
+
+  // release the arrays of the width not in use
+  if(w == 32)
+  {
+    A40 = index_arrays<40>();
+    construct(A32);
+  }
+  else
+  {
+    A32 = index_arrays<32>();
+    construct(A40);
+  }
+}
+
+template<uint8_t t_width>
+void engine::construct(index_arrays<t_width>& A)
+{
+  A.SA_map.reset();
+  A.LCP_map.reset();
+  if(opt.cache_dir.length() == 0)
+  {
+    build(A);
+    return;
+  }
+
+  phase("cache_lookup");
+  array_cache cache(opt.cache_dir, opt.symbol_bytes > 1
+                    ? cache_key(T_int, N, 32, opt.threads, opt.collection, opt.separator)
+                    : cache_key(T, N, 8, opt.threads, opt.collection, opt.separator));
+  bool hit = cache.map(N, A.SA_map, A.LCP_map);
+  if(opt.stats != nullptr)
+    opt.stats->count("cache_hit", hit);
+  if(hit)
+  {
+    // release the arrays of an earlier text
+    A.SA = int_vector<t_width>();
+    A.LCP = int_vector<t_width>();
+    return;
+  }
+
+  build(A);
+  phase("cache_store");
+  if(opt.in_memory or opt.symbol_bytes > 1)
+    cache.store<t_width>(A.SA, A.LCP, N);
+  else
+    cache.store<t_width>(SA, A.LCP, N);
+}
+
+template<uint8_t t_width>
+void engine::build(index_arrays<t_width>& A)
+{
+  phase("sa");
+  if(opt.symbol_bytes > 1)
+  {
+    build_sa(T_int, A.SA, sigma, opt.threads);
+    phase("lcp");
+    build_lcp(T_int, A);
+    return;
+  }
+
+  if(opt.in_memory)
+  {
+    build_sa(T, A.SA, opt.threads);
+    phase("lcp");
+    build_lcp(T, A);
+    return;
+  }
+
+  store_to_cache(T, conf::KEY_TEXT, cc);
+  build_sa(cc, opt.threads);
+  phase("lcp");
+  if(opt.lcp == lcp_algorithm::phi or opt.threads > 1)
+    build_lcp_phi(cc, opt.threads);
+  else
+    sdsl::construct_lcp_kasai<8>(cc);
+  SA = int_vector_buffer<>(cache_file_name(conf::KEY_SA, cc));
+
+  // load LCP array in RAM
+  int_vector_buffer<> LCP_(cache_file_name(conf::KEY_LCP, cc));
+  A.LCP.resize(N);
+  for(uint64_t i = 0; i < N; ++i)
+    A.LCP[i] = LCP_[i];
+}
+
+template<class t_text, uint8_t t_width>
+void engine::build_lcp(const t_text& text, index_arrays<t_width>& A)
+{
+  // Kasai's algorithm is sequential: more threads imply Phi
+  if(opt.lcp == lcp_algorithm::phi or opt.threads > 1)
+    build_lcp_phi(text, A.SA, A.LCP, opt.threads);
+  else
+  {
+    int_vector<t_width> ISA;
+    build_lcp_kasai(text, A.SA, ISA, A.LCP);
+  }
+}
+
+void engine::scan(const std::function<void(uint64_t)>& out)
+{
+  if(w == 32)
+    scan(A32, out);
+  else
+    scan(A40, out);
+  if(opt.stats != nullptr)
+    opt.stats->count("bwt_runs", bwtruns);
+}
+
+template<uint8_t t_width>
+void engine::scan(index_arrays<t_width>& A, const std::function<void(uint64_t)>& out)
+{
+  if(A.SA_map != nullptr and opt.symbol_bytes > 1)
+    scan(T_int, *A.SA_map, *A.LCP_map, A, out);
+  else if(A.SA_map != nullptr)
+    scan(T, *A.SA_map, *A.LCP_map, A, out);
+  else if(opt.symbol_bytes > 1)
+    scan(T_int, A.SA, A.LCP, A, out);
+  else if(opt.in_memory)
+    scan(T, A.SA, A.LCP, A, out);
+  else
+    scan(T, SA, A.LCP, A, out);
+}
+
+template<class t_text, class t_sa, class t_lcp, uint8_t t_width>
+void engine::scan(const t_text& text, t_sa& SA, const t_lcp& LCP, index_arrays<t_width>& A,
+                  const std::function<void(uint64_t)>& out)
+{
+  switch(opt.algo)
+  {
+    case algorithm::linear_time:
+      phase("scan");
+      // the chunks are scanned concurrently: SA must be in RAM or mapped
+      if(opt.threads > 1 and not std::is_same<t_sa, int_vector_buffer<>>::value)
+        bwtruns = linear_time_scan_parallel(text, SA, LCP, N, sigma, opt.threads, out);
+      else
+        bwtruns = linear_time_scan(text, SA, LCP, N, sigma, R_max, pointers, out);
+    break;
+    case algorithm::one_pass:
+      phase("scan");
+      bwtruns = one_pass_scan(text, SA, LCP, N, sigma, R_stack, out);
+    break;
+    case algorithm::lc:
+      phase("scan");
+      bwtruns = lc_scan(text, SA, LCP, N, sigma, R_cand, stack_psv, stack_nsv, out);
+    break;
+    case algorithm::plain_lc:
+      phase("psv_nsv");
+      sv(LCP, N, A.PSV, A.NSV, stack_psv, stack_nsv);
+      phase("scan");
+      bwtruns = plain_lc_scan(text, SA, A.PSV, A.NSV, N, sigma, R_cand, out);
+    break;
+    case algorithm::fm:
+      phase("psv_nsv");
+      sv(LCP, N, A.PSV, A.NSV, stack_psv, stack_nsv);
+      phase("scan");
+      bwtruns = fm_scan(text, SA, A.PSV, A.NSV, N, sigma, R_cand, out);
+    break;
+  }
+}
+
+void engine::clear_cache()
+{
+  SA = int_vector_buffer<>();
+  A32.SA_map.reset();
+  A32.LCP_map.reset();
+  A40.SA_map.reset();
+  A40.LCP_map.reset();
+
+  // remove chached files
+  for(auto key : {conf::KEY_TEXT, conf::KEY_SA, conf::KEY_ISA, conf::KEY_LCP})
+    if(cc.file_map.count(key))
+    {
+      sdsl::remove(cache_file_name(key, cc));
+      cc.file_map.erase(key);
+    }
+}
+
+} // namespace suffixient
@@ -0,0 +1,141 @@
+// Copyright (c) 2026, REGINDEX.  All rights reserved.
+// Use of this source code is governed
+// by a MIT license that can be found in the LICENSE file.
+
+#include <iostream>
+#include <vector>
+#include <algorithm>
+#include <getopt.h>
+
+#include <online.hpp>
+#include <set_writer.hpp>
+#include <input_text.hpp>
+#include <stats.hpp>
+
+using namespace std;
+
+void help(){
+
+	cout << "online [options]" << endl <<
+	"Input: ASCII files without character 0x0, appended in order to an initially empty text, or standard input. Output: smallest suffixient set of the whole text, updated after each appended batch without rebuilding SA and LCP." << endl <<
+	"Options:" << endl <<
+	"-h          Print usage info." << endl << 
+	"-i <arg>    Append the text of file <arg>, mapping it in memory. Repeat to append several files in order. If not specified, the text is read from standard input." << endl <<
+	"-B <arg>    Append each file in batches of <arg> characters. Default: the whole file." << endl <<
+	"-o <arg>    Store output to file using 64-bits unsigned integers. If not specified, output is streamed to standard output in human-readable format." << endl <<
+	"-s          Sort output. Default: false." << endl <<
+	"-z          Store the output file (-o) in the compact format: sorted, delta-varint encoded, with a header holding text length, alphabet size and algorithm. Readable by test. Default: false." << endl <<
+	"-p          Print to standard output size of suffixient set. Default: false." << endl <<
+	"-v          Print to standard output length of the text and size of suffixient set after each batch. Default: false." << endl <<
+	"--stats-json <arg>  Write wall time, CPU time and peak memory of each phase (append, scan, sort with -s or -z, output) and counters to file <arg>, as JSON." << endl;
+	exit(0);
+}
+
+int main(int argc, char** argv){
+
+	string output_file, stats_file;
+	vector<string> input_files;
+
+	bool sort = false;
+	bool rho = false;
+	bool verbose = false;
+	bool compact = false;
+	uint64_t batch = 0;
+
+	const struct option long_options[] = {
+		{"stats-json", required_argument, nullptr, 'J'},
+		{nullptr, 0, nullptr, 0}
+	};
+
+	int opt;
+	while ((opt = getopt_long(argc, argv, "hspvzo:i:B:", long_options, nullptr)) != -1){
+		switch (opt){
+			case 'h':
+				help();
+			break;
+			case 'o':
+				output_file = string(optarg);
+			break;
+			case 'i':
+				input_files.push_back(string(optarg));
+			break;
+			case 'B':
+				batch = strtoull(optarg, nullptr, 10);
+			break;
+			case 's':
+				sort=true;
+			break;
+			case 'p':
+				rho=true;
+			break;
+			case 'v':
+				verbose=true;
+			break;
+			case 'z':
+				compact=true;
+			break;
+			case 'J':
+				stats_file = string(optarg);
+			break;
+			default:
+				help();
+			return -1;
+		}
+	}
+
+	if(compact and output_file.length() == 0){
+		cerr << "Error: the compact format needs an output file (-o)" <<  endl;
+		help();
+	}
+
+	// standard input
+	if(input_files.empty())
+		input_files.push_back("");
+
+	suffixient::run_stats stats("online");
+	suffixient::online_engine E;
+	uint64_t batches = 0;
+	bool seen[256] = {false};  // characters of the text, for the header of the compact format
+
+	stats.begin("append");
+	for(auto& file: input_files){
+		suffixient::input_text in(file);
+		if(compact)
+			for(uint64_t i = 0; i < in.size(); ++i)
+				seen[uint8_t(in.data()[i])] = true;
+		uint64_t step = batch == 0 ? max<uint64_t>(in.size(), 1) : batch;
+		for(uint64_t i = 0; i < in.size(); i += step){
+			E.append(in.data() + i, min(step, in.size() - i));
+			batches++;
+			if(verbose)
+				cout << "Length " << E.length() << ", size of smallest suffixient set: " << E.size() << endl;
+		}
+	}
+
+	if(E.length() == 0){
+		cerr << "Error: empty text" <<  endl;
+		help();
+	}
+
+	stats.begin("scan");
+	suffixient::set_writer S(output_file,sort,nullptr,compact);
+	E.scan([&S](uint64_t x){ S.push(x); });
+	if(sort or compact){
+		stats.begin("sort");
+		S.sort_elements();
+	}
+	stats.begin("output");
+	// alphabet size including the terminator, as the other engines
+	S.describe(E.length(),std::count(seen,seen + 256,true) + 1,"online");
+	S.close();
+
+	if(stats_file.length() != 0){
+		stats.count("text_length", E.length());
+		stats.count("batches", batches);
+		stats.count("states", E.states());
+		stats.count("suffixient_size", S.size());
+		stats.write_json(stats_file);
+	}
+
+  if(rho) cout << "Size of smallest suffixient set: " << S.size() << endl;
+}
@@ -0,0 +1,185 @@
+// Copyright (c) 2026, REGINDEX.  All rights reserved.
+// Use of this source code is governed
+// by a MIT license that can be found in the LICENSE file.
+
+#include <online.hpp>
+
+namespace suffixient{
+
+online_engine::online_engine()
+{
+  st.push_back({0, -1, 0, false, {}});
+}
+
+void online_engine::append(const char* text, uint64_t k)
+{
+  for(uint64_t i = 0; i < k; ++i)
+    extend(uint8_t(text[i]));
+  n += k;
+}
+
+uint64_t online_engine::size() const
+{
+  uint64_t size = chi;
+  int64_t child = -1;
+  for(int64_t q = last; q != -1; child = q, q = st[q].link)
+    for(auto& e: st[q].edges)
+      size = size + supermaximal(q, e, child) - e.selected;
+  return size;
+}
+
+void online_engine::extend(uint8_t c)
+{
+  uint64_t cur = st.size();
+  st.push_back({st[last].len + 1, -1, st[last].len, false, {}});
+
+  int64_t p = last;
+  path.clear();
+  while(p != -1 and find(p, c) == nullptr)
+  {
+    path.push_back(p);
+    p = st[p].link;
+  }
+  // from the top of the path down, so that the parent of each state
+  // already has an edge labeled c
+  for(auto it = path.rbegin(); it != path.rend(); ++it)
+    add_edge(*it, c, cur);
+
+  if(p == -1)
+    set_link(cur, 0);
+  else
+  {
+    uint64_t q = find(p, c)->target;
+    if(st[p].len + 1 == st[q].len)
+      set_link(cur, q);
+    else
+    {
+      // split q: the clone takes the strings of q up to length len(p) + 1
+      uint64_t clone = st.size();
+      st.push_back({st[p].len + 1, -1, st[q].firstpos, false, st[q].edges});
+      for(auto& e: st[clone].edges)
+      {
+        e.cover = 0;
+        e.selected = false;
+      }
+      set_link(clone, st[q].link);
+      set_link(q, clone);
+      refresh(clone);
+      for(int64_t r = p; r != -1; r = st[r].link)
+      {
+        edge* e = find(r, c);
+        if(e == nullptr or e->target != q)
+          break;
+        e->target = clone;
+      }
+      set_link(cur, clone);
+    }
+  }
+  last = cur;
+}
+
+online_engine::edge* online_engine::find(uint64_t q, uint8_t c)
+{
+  for(auto& e: st[q].edges)
+    if(e.c == c)
+      return &e;
+  return nullptr;
+}
+
+void online_engine::add_edge(uint64_t q, uint8_t c, uint64_t target)
+{
+  bool was = st[q].rm;
+  st[q].edges.push_back({target, 0, c, false});
+  if(not was)
+  {
+    refresh(q);
+    return;
+  }
+  if(st[q].link != -1)
+  {
+    edge* f = find(st[q].link, c);
+    f->cover++;
+    evaluate(st[q].link, *f);
+  }
+  evaluate(q, st[q].edges.back());
+}
+
+void online_engine::set_link(uint64_t p, int64_t parent)
+{
+  if(st[p].rm)
+    attach(p, -1);
+  st[p].link = parent;
+  if(st[p].rm)
+    attach(p, +1);
+}
+
+void online_engine::refresh(uint64_t q)
+{
+  bool now = st[q].edges.size() >= 2;
+  if(now == st[q].rm)
+    return;
+  if(st[q].rm)
+    attach(q, -1);
+  st[q].rm = now;
+  if(now)
+    attach(q, +1);
+  for(auto& e: st[q].edges)
+    evaluate(q, e);
+}
+
+void online_engine::attach(uint64_t p, int sign)
+{
+  int64_t parent = st[p].link;
+  if(parent == -1)
+    return;
+  // x.a.c occurs, so a.c occurs: the parent has an edge for each edge of p
+  for(auto& e: st[p].edges)
+  {
+    edge* f = find(parent, e.c);
+    f->cover += sign;
+    evaluate(parent, *f);
+  }
+}
+
+void online_engine::evaluate(uint64_t q, edge& e)
+{
+  bool want = st[q].rm and e.cover == 0;
+  if(want == e.selected)
+    return;
+  e.selected = want;
+  if(want)
+    chi++;
+  else
+    chi--;
+}
+
+bool online_engine::supermaximal(uint64_t q, const edge& e, int64_t child) const
+{
+  // a single extension and the end of the text make q right-maximal
+  bool rm = st[q].rm or st[q].edges.size() == 1;
+  bool covered = e.cover > 0 or (child != -1 and st[child].edges.size() == 1 and
+                                 st[child].edges[0].c == e.c);
+  return rm and not covered;
+}
+
+void online_engine::scan(const std::function<void(uint64_t)>& out) const
+{
+  // states of the suffix-link path of last, each with its child on the path
+  std::vector<int64_t> child(st.size(), -2);
+  for(int64_t q = last, c = -1; q != -1; c = q, q = st[q].link)
+    child[q] = c;
+
+  for(uint64_t q = 0; q < st.size(); ++q)
+    for(auto& e: st[q].edges)
+      if(child[q] == -2 ? e.selected : supermaximal(q, e, child[q]))
+        out(st[e.target].firstpos + 1);
+}
+
+void online_engine::set(std::vector<uint64_t>& S) const
+{
+  S.clear();
+  S.reserve(chi);
+  scan([&S](uint64_t x){ S.push_back(x); });
+}
+
+} // namespace suffixient
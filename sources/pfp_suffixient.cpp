@@ -4,6 +4,9 @@
 
 #include <iostream>
 #include <limits>
+#include <thread>
+#include <vector>
+#include <getopt.h>
 
 #include <common.hpp>
 
@@ -14,67 +17,71 @@
 #include <pfp.hpp>
 #include <pfp_iterator.hpp>
 
-#include <malloc_count.h>
+#include <maxima_stack.hpp>
+#include <reverse_parse.hpp>
+#include <spsc_ring.hpp>
+#include <stats.hpp>
 
-struct lcp_maxima
-{
-  int64_t len;
-  uint64_t pos;
-  bool active;
-};
+constexpr int sigma = 256; 
+
+// a batch of consecutive entries of SA, LCP and BWT
+struct stream_batch{
+  static constexpr size_t capacity = 1 << 12;
 
-constexpr int sigma = 128; 
+  std::vector<uint64_t> sa;
+  std::vector<int_t> lcp;
+  std::vector<uint8_t> bwt;
+  size_t len = 0;  // 0 once the stream is over
+
+  stream_batch() : sa(capacity), lcp(capacity), bwt(capacity) {}
+
+  void fill(pfp_iterator& iter)
+  {
+    len = iter.next_batch(sa.data(), lcp.data(), bwt.data(), capacity);
+  }
+};
 
 void help(){
 
   std::cout << "suffixient [options]" << std::endl <<
-  "Input: Path to PFP data structures. Output: smallest suffixient set." << std::endl <<
+  "Input: Path to PFP data structures, or a text file with -f. Output: smallest suffixient set." << std::endl <<
   "Options:" << std::endl <<
   "-h          Print usage info." << std::endl << 
   "-i <arg>    Basepath for the PFP data structures." << std::endl << 
+  "-f <arg>    Text file: parse the reversed text directly, reading the file backwards, and compute the PFP data structures (-i and -n are then not needed)." << std::endl <<
+  "-m <arg>    PFP hash modulus, with -f. Default: 100." << std::endl <<
+  "-d <arg>    Scratch directory for the parse files, with -f. Default: the directory of the text." << std::endl <<
+  "-k          Keep the parse files, with -f. Default: false." << std::endl <<
   "-o <arg>    Store output to file using 64-bits unsigned integers. If not specified, output is streamed to standard output in human-readable format." << std::endl <<
-  "-w <arg>    PFP trigger strings size." << std::endl << 
-  "-n <arg>    Text length." << std::endl <<
+  "-w <arg>    PFP trigger strings size. Default: 10." << std::endl << 
+  "-n <arg>    Text length (plus one)." << std::endl <<
+  "-t <arg>    Number of threads. With more than 1, the text given with -f is parsed in parallel segments, and SA, LCP and BWT are streamed by a producer thread while the scan runs on another. Default: 1." << std::endl <<
   "-p          Print to standard output size of suffixient set. Default: false." << std::endl <<
-  "-r          Print to standard output number of equal-letter runs in the BWT of reverse text. Default: false." << std::endl;
+  "-r          Print to standard output number of equal-letter runs in the BWT of reverse text. Default: false." << std::endl <<
+  "--stats-json <arg>  Write wall time, CPU time and peak memory of each phase (parse with -f, loading, iterator_setup, streaming) and counters to file <arg>, as JSON." << std::endl;
   exit(0);
 }
 
-inline void eval(int64_t l, uint64_t& size, std::vector<lcp_maxima>& R, 
-                 std::string output_file, FILE *suffixient_file)
-{
-  for(uint8_t c = 1; c < sigma; ++c)
-    if(l < R[c].len)
-    {
-      // process an active candidate
-      if(R[c].active)
-      {
-        size++;
-        if(output_file.length() == 0)
-          std::cout << R[c].pos << " ";
-        else
-          if (fwrite(&R[c].pos, SSABYTES, 1, suffixient_file) != 1)
-            error("S write error 1");
-      }
-      // update to inactive state
-      R[c] = {l,0,false};
-    }
-}
-
 int main(int argc, char* const argv[])
 {
   if(argc<2) help();
 
-  std::string output_file, input_path;
+  std::string output_file, input_path, text_file, scratch_dir, stats_file;
 
-  bool sort=false, chi=false, runs=false;
+  bool sort=false, chi=false, runs=false, keep=false;
 
   FILE *suffixient_file;
 
-  int w, N;
+  int w = 10;
+  uint64_t N = 0, mod = 100, threads = 1;
+
+  const struct option long_options[] = {
+    {"stats-json", required_argument, nullptr, 'J'},
+    {nullptr, 0, nullptr, 0}
+  };
 
   int opt;
-  while ((opt = getopt(argc, argv, "prsho:w:n:i:")) != -1){
+  while ((opt = getopt_long(argc, argv, "prskho:w:n:i:f:m:d:t:", long_options, nullptr)) != -1){
     switch (opt){
       case 'h':
         help();
@@ -89,7 +96,22 @@ int main(int argc, char* const argv[])
         w = atoi(optarg);
       break;
       case 'n':
-        N = atoi(optarg);
+        N = std::strtoull(optarg, nullptr, 10);
+      break;
+      case 'f':
+        text_file = std::string(optarg);
+      break;
+      case 'm':
+        mod = std::strtoull(optarg, nullptr, 10);
+      break;
+      case 'd':
+        scratch_dir = std::string(optarg);
+      break;
+      case 'k':
+        keep = true;
+      break;
+      case 't':
+        threads = std::strtoull(optarg, nullptr, 10);
       break;
       case 'p':
         chi = true;
@@ -97,17 +119,48 @@ int main(int argc, char* const argv[])
       case 'r':
         runs = true;
       break;
+      case 'J':
+        stats_file = std::string(optarg);
+      break;
       default:
         help();
       return -1;
     }
   }
 
+  suffixient::run_stats stats("pfp_suffixient");
+
+  // parse the reversed text, writing the parse files in the scratch directory
+  if(text_file.length() != 0)
+  {
+    stats.begin("parse");
+    input_path = text_file;
+    if(scratch_dir.length() != 0)
+      input_path = scratch_dir + "/" + text_file.substr(text_file.find_last_of('/') + 1);
+    try{
+      suffixient::reverse_parser parser(w, mod);
+      N = parser.run(text_file, input_path, threads) + 1;
+      stats.count("dictionary_phrases", parser.dictionary_size());
+      stats.count("parse_length", parser.parse_size());
+    }catch(const std::exception& e){
+      error(e.what());
+    }
+  }
+
   // compute PFP data structures
+  stats.begin("loading");
   pf_parsing pf(input_path, w);
 
+  // the parse files are no longer needed
+  if(text_file.length() != 0 and not keep)
+    for(auto ext: {".dict", ".occ", ".parse"})
+      std::remove((input_path + ext).c_str());
+
   // compute PFP iterator
-  pfp_iterator iter(pf, input_path);
+  stats.begin("iterator_setup");
+  sdsl::int_vector<> ilist = compact_ilist(pf);
+  pfp_iterator iter(pf, ilist, input_path);
+  stats.begin("streaming");
 
   // opening output files
   if(output_file.length() != 0)
@@ -122,51 +175,108 @@ int main(int argc, char* const argv[])
   * algorithm: compute suffixient-nexessary set by streaming SA, LCP, and BWT using the PFP data structures.
   */
 
-  // move forward pfp iterator to first position
-  uint64_t i=1; ++iter; 
-  char p = iter.get_bwt(), c;
-  uint64_t p_sa = iter.get_sa(), c_sa;
+  // stream SA, LCP and BWT in batches: with more than one thread, the batches
+  // are filled by a producer thread and handed over through a ring buffer
+  suffixient::spsc_ring<stream_batch> ring(threads > 1 ? 8 : 1);
+  std::thread producer;
+  if(threads > 1)
+    producer = std::thread([&](){
+      bool over = false;
+      while(not over)
+      {
+        stream_batch& b = ring.write_slot();
+        b.fill(iter);
+        over = b.len == 0;
+        ring.push();
+      }
+    });
+  auto next_batch = [&]() -> const stream_batch& {
+    if(threads <= 1)
+    {
+      ring.write_slot().fill(iter);
+      ring.push();
+    }
+    return ring.read_slot();
+  };
+
+  // start from the first position
+  const stream_batch* b = &next_batch();
+  uint8_t p = b->len > 0 ? b->bwt[0] : 0;
+  uint64_t p_sa = b->len > 0 ? b->sa[0] : 0;
   
-  uint64_t bwtruns=1, suffixient_size=0; //tot_size = 1;
+  uint64_t bwtruns=1, suffixient_size=0, candidates=0; //tot_size = 1;
   int64_t m = std::numeric_limits<int64_t>::max();
-  // vector STORING candidate suffixient right-extensions
-  std::vector<lcp_maxima> r_ext(sigma,{-1,0,false});
+  // candidate suffixient right-extensions
+  suffixient::maxima_stack r_ext;
+  r_ext.reset(sigma);
+  // process an active candidate
+  auto out = [&](uint64_t pos){
+    suffixient_size++;
+    if(output_file.length() == 0)
+      std::cout << pos << " ";
+    else
+      if (fwrite(&pos, SSABYTES, 1, suffixient_file) != 1)
+        error("S write error 1");
+  };
   
   // iterate until all values have been streamed
-  while( ++iter )
+  for(size_t k = 1; b->len > 0; k = 0)
   {
-    // read current values from the stream
-    m = std::min(m,int64_t(iter.get_lcp()));
-    c = iter.get_bwt();
-    c_sa = iter.get_sa();
-    //tot_size++;
-
-    if(c != p)
+    const uint64_t *sa = b->sa.data();
+    const int_t *lcp = b->lcp.data();
+    const uint8_t *bwt = b->bwt.data();
+    for(; k < b->len; ++k)
     {
-      // evaluate sigma candidates
-      eval(m,suffixient_size,r_ext,output_file,suffixient_file);
-      // update p and c candidates
-      if(iter.get_lcp() > r_ext[p].len) 
-        r_ext[p] = {iter.get_lcp(),N - p_sa,true};
-      if(iter.get_lcp() > r_ext[c].len) 
-        r_ext[c] = {iter.get_lcp(),N - c_sa,true};  
-      // reset LCP value
-      m = std::numeric_limits<int64_t>::max();
-      // increment number of runs
-      bwtruns++;
+      // read current values from the batch
+      m = std::min(m,int64_t(lcp[k]));
+
+      if(bwt[k] != p)
+      {
+        // evaluate the candidates expiring at this run boundary
+        r_ext.eval(m,out);
+        // update p and c candidates
+        if(int64_t(lcp[k]) > r_ext.len(p)){
+          r_ext.set(p,lcp[k],N - p_sa);
+          candidates++;
+        }
+        if(int64_t(lcp[k]) > r_ext.len(bwt[k])){
+          r_ext.set(bwt[k],lcp[k],N - sa[k]);
+          candidates++;
+        }
+        // reset LCP value
+        m = std::numeric_limits<int64_t>::max();
+        // increment number of runs
+        bwtruns++;
+        // update the previous BWT character
+        p = bwt[k];
+      }
+      // update the previous SA entry
+      p_sa = sa[k];
     }
-    
-    // update the previous BWT character and SA entry
-    p = c; p_sa = c_sa;
+    ring.pop();
+    b = &next_batch();
   }
+  ring.pop();
+  if(producer.joinable())
+    producer.join();
+
   // evaluate last active candidates
-  eval(-1,suffixient_size,r_ext,output_file,suffixient_file);
+  r_ext.eval(-1,out);
 
   if(output_file.length() == 0)
       std::cout << std::endl;
   else
       fclose(suffixient_file);
 
+  if(stats_file.length() != 0)
+  {
+    stats.count("text_length", N - 1);
+    stats.count("bwt_runs", bwtruns);
+    stats.count("candidates", candidates);
+    stats.count("suffixient_size", suffixient_size);
+    stats.write_json(stats_file);
+  }
+
   if(chi)
     std::cout << "Size of smallest suffixient set: " << suffixient_size << std::endl;
   if(runs)
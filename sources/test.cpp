@@ -4,46 +4,99 @@
 // by a MIT license that can be found in the LICENSE file.
 
 #include <iostream>
-#include <sdsl/construct.hpp>
-#include <set>
+#include <fstream>
+#include <vector>
+#include <memory>
+#include <atomic>
 #include <limits>
 #include <algorithm>
-#include <ctime>
-#include <unistd.h>
+#include <getopt.h>
+
+#include <input_text.hpp>
+#include <build.hpp>
+#include <scan.hpp>
+#include <parallel.hpp>
+#include <set_format.hpp>
+#include <array_cache.hpp>
+#include <stats.hpp>
 
 using namespace std;
 using namespace sdsl;
 
-int_vector<8> T_rev;
-int_vector_buffer<> SA;
-int_vector_buffer<> LCP_;
-
-inline uint8_t BWT(uint64_t i){
-  return SA[i] == 0 ? 0 : T_rev[SA[i] - 1];
-}
-
+/*
+ * The verifier keeps the text, SA, LCP, PSV and NSV of T^{rev} in RAM as
+ * bit-compressed arrays (32 or 40 bits per entry), the BWT in one byte
+ * per entry and no ISA: SA, LCP and the text are released as soon as the
+ * set has been mapped to the BWT. The checks of the BWT symbols are
+ * independent, so each thread verifies a group of symbols.
+ */
 
 void help(){
 
-  cout << "Test usage: ./test input_file input_set" << endl <<
+  cout << "Test usage: ./test [-T threads] [-C cache_dir] [--stats-json file] input_file input_set" << endl <<
   "input_file: the filename for a non-empty ASCII file without character 0x0." << endl <<
-  "input_set: the filename for a file containing the set being tested in the following format: one uint64_t storing the size |S| of the set, followed by |S| uint64_t storing the set itself." << endl <<
+  "input_set: the filename for a file containing the set being tested in the following format: one uint64_t storing the size |S| of the set, followed by |S| uint64_t storing the set itself, or the compact format written by the tools with option -z." << endl <<
+  "-T <arg>: number of threads for suffix and LCP array construction (parallel libsais and Phi if greater than 1) and for the verification. Default: 1." << endl <<
+  "-C <arg>: persistent cache directory of SA and LCP, as option -C of the tools. The text is remapped as with their option -t, so the arrays are shared with runs using -t. Default: none." << endl <<
+  "--stats-json <arg>: write wall time, CPU time and peak memory of each phase (ingestion, sa, lcp or cache_lookup, mapping, psv_nsv, classify, suffixiency, minimality) and counters, including the result code, to file <arg>, as JSON." << endl <<
   "Warning: if 0x0 appears within the file, the file is read only until the first occurrence of 0x0 (excluded)." << endl;
   exit(0);
 }
 
+// BWT of T^{rev}, 0 for the first suffix
+template<class t_sa>
+int_vector<8> bwt(const int_vector<8> & T, const t_sa & SA, uint64_t threads) {
+  uint64_t N = SA.size();
+  int_vector<8> L(N);
+  // blocks of 8 entries share no word of L
+  suffixient::parallel_blocks(N, threads, 8, [&](uint64_t b, uint64_t e){
+    for (uint64_t i = b; i < e; i++) {
+      L[i] = SA[i] == 0 ? 0 : T[SA[i] - 1];
+    }
+  });
+  return L;
+}
 
-inline vector<uint64_t> map_to_BWT(vector<uint64_t> & S, vector<uint64_t> & ISA,\
-  uint64_t N) {
-  vector<uint64_t> mapped;
+// sorted BWT positions of the text positions N - x, x in S. Returns false if
+// an element is out of range (x = N would be the terminator, not a text
+// position); duplicates are dropped and counted in dup.
+template<class t_sa>
+bool map_to_BWT(const vector<uint64_t> & S, const t_sa & SA, uint64_t threads,\
+  vector<uint64_t> & A, uint64_t & dup) {
+  uint64_t N = SA.size();
+  bit_vector marked(N, 0);
+  dup = 0;
   for (auto element:S) {
-    mapped.push_back(ISA[N - element]);
+    if (element == 0 or element >= N) {
+      return false;
+    }
+    if (marked[N - element]) {
+      dup++;
+    }
+    marked[N - element] = 1;
   }
-  return mapped;
+
+  uint64_t block = (N + threads - 1) / threads;
+  vector<vector<uint64_t>> found(threads);
+  suffixient::parallel_for(threads, [&](uint64_t k){
+    for (uint64_t i = k * block; i < min(N, (k + 1) * block); i++) {
+      if (marked[SA[i]]) {
+        found[k].push_back(i);
+      }
+    }
+  });
+  A.clear();
+  for (auto & f:found) {
+    A.insert(A.end(), f.begin(), f.end());
+    vector<uint64_t>().swap(f);
+  }
+  return true;
 }
 
-inline uint64_t i_max(vector<int64_t> & LCP, uint64_t i) {
-  if (i < (LCP.size() - 1) and LCP[i] <= LCP[i + 1]) {
+// position of the largest of LCP[i] and LCP[i + 1]
+template<class t_lcp>
+inline uint64_t i_max(const t_lcp & LCP, uint64_t i) {
+  if (i + 1 < LCP.size() and LCP[i] <= LCP[i + 1]) {
     return (i + 1);
   }
   else {
@@ -51,33 +104,61 @@ inline uint64_t i_max(vector<int64_t> & LCP, uint64_t i) {
   }
 }
 
-vector<vector<uint64_t>> classify_by_bwt_symbol(vector<uint64_t> & S, uint64_t N,\
-  vector<int64_t> & LCP, uint8_t sigma) {
-  vector<vector<uint64_t>> classified;
-
-  for (uint64_t i = 0; i < sigma; i++) {
-    classified.push_back(vector<uint64_t> ());
-  }
-  for (auto element:S) {
-    classified[BWT(element)].push_back(i_max(LCP, element));
+template<class t_lcp>
+vector<vector<uint64_t>> classify_by_bwt_symbol(const vector<uint64_t> & A,\
+  const int_vector<8> & L, const t_lcp & LCP, uint64_t sigma) {
+  vector<vector<uint64_t>> classified(sigma);
+  for (auto element:A) {
+    classified[L[element]].push_back(i_max(LCP, element));
   }
   return classified;
 }
 
+// symbols verified by each thread, balancing their number of occurrences
+vector<vector<uint64_t>> assign_symbols(const int_vector<8> & L, uint64_t sigma,\
+  uint64_t threads) {
+  vector<uint64_t> occ(sigma, 0), symbols, load(threads, 0);
+  for (uint64_t i = 0; i < L.size(); i++) {
+    occ[L[i]]++;
+  }
+  for (uint64_t c = 1; c < sigma; c++) {
+    symbols.push_back(c);
+  }
+  sort(symbols.begin(), symbols.end(), [&](uint64_t a, uint64_t b){ return occ[a] > occ[b]; });
+  vector<vector<uint64_t>> owned(threads);
+  for (auto c:symbols) {
+    uint64_t k = min_element(load.begin(), load.end()) - load.begin();
+    owned[k].push_back(c);
+    load[k] += occ[c];
+  }
+  return owned;
+}
 
-bool suffixiency(vector<vector<uint64_t>> C, uint64_t N, vector<int64_t> & PSV, \
-  vector<int64_t> & NSV, uint8_t sigma) {
-
-  vector<int64_t> P(sigma);
+// every run boundary i of the BWT, with c = BWT[i - 1] or c = BWT[i], needs
+// an element of C[c] in the interval (PSV[i], NSV[i]). PSV is shifted by
+// one, as computed by suffixient::sv.
+template<class t_sv>
+bool suffixiency(const vector<vector<uint64_t>> & C, const int_vector<8> & L,\
+  const t_sv & PSV, const t_sv & NSV, const vector<uint64_t> & symbols,\
+  atomic<bool> & ok) {
+  uint64_t N = L.size();
+  vector<bool> mine(C.size(), false);
+  for (auto c:symbols) {
+    mine[c] = true;
+  }
+  vector<uint64_t> P(C.size(), 0);
   for (uint64_t i = 1; i < N; i++) {
-    if (BWT(i - 1) != BWT(i)) {
+    if ((i & 0xffff) == 0 and !ok) {
+      return false;
+    }
+    if (L[i - 1] != L[i]) {
       for (uint64_t ip = i - 1; ip <= i; ip++) {
-        uint64_t c = BWT(ip);
-        if (c != 0) {
+        uint64_t c = L[ip];
+        if (mine[c]) {
           if (C[c].empty()) {
             return false;
           }
-          while (int64_t(C[c][P[c]]) <= PSV[i]) {
+          while (C[c][P[c]] < PSV[i]) {
             if (P[c] == C[c].size() - 1) {
               return false;
             }
@@ -93,11 +174,13 @@ bool suffixiency(vector<vector<uint64_t>> C, uint64_t N, vector<int64_t> & PSV,
   return true;
 }
 
-bool minimality(vector<vector<uint64_t>> C, vector<int64_t> & PSV, \
-  vector<int64_t> & NSV, uint8_t sigma) {
-  for(auto symbol_list:C) {
-    for (uint64_t i = 1; i < symbol_list.size(); i++) {
-      if (PSV[symbol_list[i]] < NSV[symbol_list[i - 1]]) {
+// the intervals of consecutive elements of C[c] must be disjoint
+template<class t_sv>
+bool minimality(const vector<vector<uint64_t>> & C, const t_sv & PSV,\
+  const t_sv & NSV, const vector<uint64_t> & symbols) {
+  for (auto c:symbols) {
+    for (uint64_t i = 1; i < C[c].size(); i++) {
+      if (PSV[C[c][i]] <= NSV[C[c][i - 1]]) {
         return false;
       }
     }
@@ -105,117 +188,186 @@ bool minimality(vector<vector<uint64_t>> C, vector<int64_t> & PSV, \
   return true;
 }
 
-// modifies psv and nsv vectors with PSV(LCP) and NSV(LCP), respectively
-void sv(vector<int64_t> LCP, vector<int64_t> & psv, vector<int64_t> & nsv) {
-  uint64_t N = LCP.size() - 1;
-  vector<uint64_t> stack_nsv;
-  vector<uint64_t> stack_psv;
-  nsv = vector<int64_t>(N, N);
-  psv = vector<int64_t>(N, -1);
-  for (int64_t i = 0; i < N; i++) {
-    while (!stack_nsv.empty() and LCP[i] < LCP[stack_nsv.back()]) {
-      nsv[stack_nsv.back()] = i;
-      stack_nsv.pop_back();
+// free an array built in RAM; mapped arrays are left to the page cache
+template<uint8_t t_width>
+void release(int_vector<t_width> & v) {
+  v = int_vector<t_width>();
+}
+
+template<class t_array>
+void release(t_array &) {}
+
+// 0: suffixient of smallest cardinality, 1: not suffixient, 2: not smallest
+template<uint8_t t_width, class t_sa, class t_lcp>
+int check(int_vector<8> & T, t_sa & SA, t_lcp & LCP, uint64_t sigma,\
+  const vector<uint64_t> & S, uint64_t threads, suffixient::run_stats & stats) {
+  uint64_t N = T.size();
+
+  stats.begin("mapping");
+  int_vector<t_width> PSV, NSV;
+  int_vector<8> L = bwt(T, SA, threads);
+  T = int_vector<8>();
+
+  vector<uint64_t> A;
+  uint64_t dup;
+  if (!map_to_BWT(S, SA, threads, A, dup)) {
+    cerr << "The given set contains positions out of the text." << endl;
+    return 1;
+  }
+  release(SA);
+  stats.count("duplicates", dup);
+
+  stats.begin("psv_nsv");
+  {
+    vector<uint64_t> stack_psv, stack_nsv;
+    suffixient::sv(LCP, N, PSV, NSV, stack_psv, stack_nsv);
+  }
+  stats.begin("classify");
+  vector<vector<uint64_t>> C = classify_by_bwt_symbol(A, L, LCP, sigma);
+  release(LCP);
+  vector<uint64_t>().swap(A);
+
+  vector<vector<uint64_t>> owned = assign_symbols(L, sigma, threads);
+
+  stats.begin("suffixiency");
+  atomic<bool> ok(true);
+  suffixient::parallel_for(threads, [&](uint64_t k){
+    if (!suffixiency(C, L, PSV, NSV, owned[k], ok)) {
+      ok = false;
     }
-    stack_nsv.push_back(i);
-    while(!stack_psv.empty() and LCP[i] <= LCP[stack_psv.back()]) {
-      stack_psv.pop_back();
+  });
+  if (!ok) {
+    return 1;
+  }
+
+  stats.begin("minimality");
+  suffixient::parallel_for(threads, [&](uint64_t k){
+    if (!minimality(C, PSV, NSV, owned[k])) {
+      ok = false;
     }
-    if (!stack_psv.empty()) {
-      psv[i] = stack_psv.back();
+  });
+  if (!ok or dup > 0) {
+    return 2;
+  }
+  return 0;
+}
+
+// SA and LCP of T are mapped from cache_dir if cached there, otherwise built
+// (and stored in cache_dir, if given)
+template<uint8_t t_width>
+int verify(int_vector<8> & T, uint64_t sigma, const vector<uint64_t> & S,\
+  uint64_t threads, const string & cache_dir, suffixient::run_stats & stats) {
+  uint64_t N = T.size();
+  unique_ptr<suffixient::array_cache> cache;
+  if (cache_dir.length() != 0) {
+    stats.begin("cache_lookup");
+    cache.reset(new suffixient::array_cache(cache_dir, suffixient::cache_key(T, N, 8, threads)));
+    unique_ptr<sdsl::read_only_mapper<t_width>> SA, LCP;
+    bool hit = cache->map(N, SA, LCP);
+    stats.count("cache_hit", hit);
+    if (hit) {
+      return check<t_width>(T, *SA, *LCP, sigma, S, threads, stats);
     }
-    stack_psv.push_back(i);
   }
+
+  int_vector<t_width> SA, LCP;
+  stats.begin("sa");
+  suffixient::build_sa(T, SA, threads);
+  stats.begin("lcp");
+  suffixient::build_lcp_phi(T, SA, LCP, threads);
+  if (cache) {
+    stats.begin("cache_store");
+    cache->store<t_width>(SA, LCP, N);
+  }
+  return check<t_width>(T, SA, LCP, sigma, S, threads, stats);
 }
 
 int main(int argc, char** argv){
-  srand(time(NULL));
-  cache_config cc;
-  string input_file, input_set, in;
+  string input_file, input_set, cache_dir, stats_file;
+  int threads = 1;
+
+  const struct option long_options[] = {
+    {"stats-json", required_argument, nullptr, 'J'},
+    {nullptr, 0, nullptr, 0}
+  };
+
+  int opt;
+  while ((opt = getopt_long(argc, argv, "hT:C:", long_options, nullptr)) != -1) {
+    switch (opt) {
+      case 'T':
+        threads = atoi(optarg);
+      break;
+      case 'C':
+        cache_dir = optarg;
+      break;
+      case 'J':
+        stats_file = optarg;
+      break;
+      default:
+        help();
+      return -1;
+    }
+  }
+  threads = max(threads, 1);
 
-  if (argc == 3) {
-    input_file = argv[1];
-    input_set = argv[2];
+  if (argc - optind == 2) {
+    input_file = argv[optind];
+    input_set = argv[optind + 1];
   }
   else {
     help();
     return -1;
   }
 
+  suffixient::run_stats stats("test");
+  stats.begin("ingestion");
   vector<uint64_t> S;
   uint64_t N = 0;
-  ifstream set_file(input_set);
-  string line;
-  if (set_file.is_open()) {
-    uint64_t size;
-    set_file.read(reinterpret_cast<char*>(&size), sizeof(size));
-    S.resize(size);
-    set_file.read(reinterpret_cast<char*>(S.data()), sizeof(uint64_t)*size);
-    set_file.close();
-  }
-
-  ifstream file(input_file);
-  if (file.is_open()) {
-    getline(file, in, char(0));
-    file.close();
-  }
-
-  N = in.size() + 1;
-  uint8_t sigma = 1; 
-  T_rev = int_vector<8>(N - 1);
+  suffixient::load_set(input_set, S);
 
-  vector<uint8_t> char_to_int(256, 0);
-  
-  for(uint64_t i = 0; i < N - 1; ++i)
+  // T^{rev} with characters mapped to 1,2,...,sigma-1 and terminated by 0
+  int_vector<8> T_rev;
+  uint64_t sigma = 1;
   {
-      uint8_t c = in[N - i - 2];
-      if(char_to_int[c] == 0) char_to_int[c] = sigma++;
-      T_rev[i] = char_to_int[c];
-  }
-
-  append_zero_symbol(T_rev);
-  store_to_cache(T_rev, conf::KEY_TEXT, cc);
-  construct_sa<8>(cc);
-  construct_lcp_kasai<8>(cc);
-  SA = int_vector_buffer<>(cache_file_name(conf::KEY_SA, cc));
-  LCP_ = int_vector_buffer<>(cache_file_name(conf::KEY_LCP, cc));
+    // map the input text in memory
+    suffixient::input_text in(input_file);
 
-  // insert LCP array in a C++ vector
-  std::vector<int64_t> LCP(N + 1, 0);
-  for(uint64_t i=0;i<N;++i)
-    LCP[i] = LCP_[i];
+    N = in.size() + 1;
+    T_rev = int_vector<8>(N);
 
-  vector<int64_t> NSV, PSV;
-  //sv modifies PSV and NSV vectors
-  sv(LCP, PSV, NSV);
+    vector<uint8_t> char_to_int(256, 0);
 
-  // inverse suffix-array for T^{rev}
-  vector <uint64_t> ISA(N);
-  for(uint64_t i = 0; i < N; i++) {
-    ISA[SA[i]] = i;
+    for(uint64_t i = 0; i < N - 1; ++i)
+    {
+        uint8_t c = in.data()[N - i - 2];
+        if(char_to_int[c] == 0) char_to_int[c] = sigma++;
+        T_rev[i] = char_to_int[c];
+    }
+    T_rev[N - 1] = 0;
   }
 
-  vector<uint64_t> A = map_to_BWT(S, ISA, N);
-  std::sort(A.begin(), A.end());
-  vector<vector<uint64_t>> C = classify_by_bwt_symbol(A, N, LCP, sigma);
+  stats.count("text_length", N - 1);
+  stats.count("alphabet_size", sigma);
+  stats.count("set_size", S.size());
 
+  int result = suffixient::index_width(N) == 32 ? verify<32>(T_rev, sigma, S, threads, cache_dir, stats)
+                                                : verify<40>(T_rev, sigma, S, threads, cache_dir, stats);
 
-  if (!suffixiency(C, N, PSV, NSV, sigma)) {
+  if (stats_file.length() != 0) {
+    stats.count("result", result);
+    stats.write_json(stats_file);
+  }
+
+  if (result == 1) {
     cerr << "The given set is not suffixient." << endl;
     return 1;
   }
-  if (!minimality(C, PSV, NSV, sigma)) {
+  if (result == 2) {
     cerr << "The given set is suffixient but not of smallest cardinality." << endl;
     return 2;
   }
 
   cout << "The given set is suffixient of smallest cardinality" << endl;
 
-  // remove chached files
-  sdsl::remove(cache_file_name(conf::KEY_TEXT, cc));
-  sdsl::remove(cache_file_name(conf::KEY_SA, cc));
-  sdsl::remove(cache_file_name(conf::KEY_ISA, cc));
-  sdsl::remove(cache_file_name(conf::KEY_LCP, cc));
-
   return 0;
 }
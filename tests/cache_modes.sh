@@ -0,0 +1,35 @@
+#!/bin/sh
+# Run suffixient on one text with and without collection mode (-c), in both
+# orders, against one persistent cache directory (-C): each mode must get its
+# own arrays, even for a text without newlines, and the sets must match the
+# ones computed without the cache.
+# usage: cache_modes.sh <suffixient> <scratch dir>
+set -e
+suffixient=$1; dir=$2
+mkdir -p "$dir"
+
+# pseudo-random DNA documents, and a single line
+awk 'BEGIN{x=11; for(i=0;i<400;i++){x=(x*1103515245+12345)%2147483648; printf "%s", substr("ACGT\n",int(x/65536)%5+1,1)}}' > "$dir/documents.txt"
+awk 'BEGIN{x=13; for(i=0;i<400;i++){x=(x*1103515245+12345)%2147483648; printf "%s", substr("ACGT",int(x/65536)%4+1,1)}}' > "$dir/line.txt"
+
+for text in documents line; do
+  "$suffixient" -i "$dir/$text.txt" -s -o "$dir/plain.expected"
+  "$suffixient" -i "$dir/$text.txt" -c -s -o "$dir/collection.expected"
+  for order in "plain collection" "collection plain"; do
+    rm -rf "$dir/cache"
+    # the second round maps the cached arrays
+    for round in 1 2; do
+      for mode in $order; do
+        flag=""
+        if [ $mode = collection ]; then flag="-c"; fi
+        "$suffixient" -i "$dir/$text.txt" $flag -C "$dir/cache" -s -o "$dir/$mode.set"
+        cmp "$dir/$mode.set" "$dir/$mode.expected"
+      done
+    done
+    arrays=$(ls "$dir/cache" | grep -c '\.sa$')
+    if [ "$arrays" != 2 ]; then
+      echo "$text, $order: $arrays cached suffix arrays instead of 2"
+      exit 1
+    fi
+  done
+done
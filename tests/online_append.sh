@@ -0,0 +1,30 @@
+#!/bin/sh
+# Append texts one character at a time with the online engine: after every
+# character the size of its set must match the one computed from scratch by
+# suffixient on the same prefix, and the final set must pass the verifier.
+# usage: online_append.sh <online> <suffixient> <test> <scratch dir>
+set -e
+online=$1; suffixient=$2; verifier=$3; dir=$4
+mkdir -p "$dir"
+
+# repetitive (a^20 b)^15 a^5, a unary run, and a pseudo-random DNA text
+awk 'BEGIN{for(j=0;j<15;j++){for(i=0;i<20;i++)printf "a"; printf "b"} printf "aaaaa"}' > "$dir/repetitive.txt"
+printf 'aaaaaaaaaaaaaaaaaaaaaaaaaaaaaa' > "$dir/unary.txt"
+awk 'BEGIN{x=7; for(i=0;i<300;i++){x=(x*1103515245+12345)%2147483648; printf "%s", substr("ACGT",int(x/65536)%4+1,1)}}' > "$dir/random.txt"
+
+for text in repetitive unary random; do
+  "$online" -i "$dir/$text.txt" -B 1 -v -o "$dir/$text.set" | sed 's/.*: //' > "$dir/$text.online"
+  n=$(wc -c < "$dir/$text.txt")
+  i=1
+  while [ $i -le $n ]; do
+    head -c $i "$dir/$text.txt" > "$dir/prefix.txt"
+    expected=$("$suffixient" -i "$dir/prefix.txt" -o "$dir/prefix.set" -p | sed 's/.*: //')
+    got=$(sed -n "${i}p" "$dir/$text.online")
+    if [ "$expected" != "$got" ]; then
+      echo "$text: prefix of length $i has a set of size $got instead of $expected"
+      exit 1
+    fi
+    i=$((i + 1))
+  done
+  "$verifier" "$dir/$text.txt" "$dir/$text.set"
+done